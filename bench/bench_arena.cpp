@@ -0,0 +1,65 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_arena.cpp
+//
+// Временные множества в монотонной арене (pmr::monotonic_buffer_resource),
+// освобождаемой целиком после каждого запроса, в сравнении с ресурсом
+// памяти по умолчанию
+//   bench_arena [мощность универса] [к-во запросов] [множеств в запросе]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+// один "запрос": набор временных множеств и операции над ними
+static long long Request(int mp, int sets, int seed, pmr::memory_resource *res)
+{
+  long long sum = 0;
+  TSet acc(mp, res);
+  for (int i = 0; i < sets; i++)
+  {
+    TSet s(mp, res);
+    s.InsElem((seed + i * 31) % mp);
+    s.InsElem((seed * 7 + i) % mp);
+    TSet t = (s + acc) * ~s;
+    acc += s;
+    sum += t.FindFirst();
+  }
+  return sum + acc.Cardinality();
+}
+
+int main(int argc, char **argv)
+{
+  int mp = (argc > 1) ? atoi(argv[1]) : 4096;
+  int requests = (argc > 2) ? atoi(argv[2]) : 10000;
+  int sets = (argc > 3) ? atoi(argv[3]) : 100;
+
+  cout << "universe: " << mp << ", requests: " << requests
+       << ", sets per request: " << sets << endl;
+
+  long long sum = 0;
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < requests; r++)
+    sum += Request(mp, sets, r, pmr::get_default_resource());
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << "default resource: " << sec * 1e3 << " ms (checksum " << sum << ")" << endl;
+
+  // буфер арены переиспользуется между запросами, release() освобождает
+  // все множества запроса сразу
+  std::vector<char> buf(size_t(sets) * 4 * (mp / 8 + 64));
+  pmr::monotonic_buffer_resource arena(&buf[0], buf.size());
+  sum = 0;
+  t0 = TClock::now();
+  for (int r = 0; r < requests; r++)
+  {
+    sum += Request(mp, sets, r, &arena);
+    arena.release();
+  }
+  sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << "monotonic arena : " << sec * 1e3 << " ms (checksum " << sum << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,99 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_bitops.cpp
+//
+// Производительность ядер поразрядных операций: ГБ/с для каждого набора
+// инструкций в сравнении с простым скалярным циклом
+//   bench_bitops [к-во битов] [к-во повторов]
+
+#include "tbitfield.h"
+#include "tbitops.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+// простой цикл по эл-там, с которым сравниваются ядра
+static void LoopOr(TELEM *dst, const TELEM *a, const TELEM *b, int n)
+{
+  for (int i = 0; i < n; i++)
+    dst[i] = a[i] | b[i];
+}
+
+static void LoopAnd(TELEM *dst, const TELEM *a, const TELEM *b, int n)
+{
+  for (int i = 0; i < n; i++)
+    dst[i] = a[i] & b[i];
+}
+
+static void LoopNot(TELEM *dst, const TELEM *a, const TELEM *, int n)
+{
+  for (int i = 0; i < n; i++)
+    dst[i] = ~a[i];
+}
+
+static void KernelNot(TELEM *dst, const TELEM *a, const TELEM *, int n)
+{
+  BitNot(dst, a, n);
+}
+
+typedef void (*TKernel)(TELEM *dst, const TELEM *a, const TELEM *b, int n);
+
+// ГБ/с по объему прочитанных и записанных данных
+static double Measure(TKernel k, int operands, TELEM *dst, const TELEM *a,
+                      const TELEM *b, int n, int reps)
+{
+  k(dst, a, b, n); // прогрев
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    k(dst, a, b, n);
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  double bytes = double(n) * sizeof(TELEM) * (operands + 1) * reps;
+  return bytes / sec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 64 * 1024 * 1024;
+  int reps = (argc > 2) ? atoi(argv[2]) : 20;
+  int n = (bits + sizeof(TELEM) * 8 - 1) / (sizeof(TELEM) * 8);
+
+  std::vector<TELEM> a(n), b(n), dst(n);
+  srand(1);
+  for (int i = 0; i < n; i++)
+  {
+    a[i] = TELEM(rand()) * 2654435761u;
+    b[i] = TELEM(rand()) * 2246822519u;
+  }
+
+  const TBitOpsIsa isas[] = { BITOPS_SCALAR, BITOPS_SSE2, BITOPS_AVX2, BITOPS_AVX512 };
+  TBitOpsIsa best = BitOpsGetIsa();
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  cout << "kernel     or GB/s  and GB/s  not GB/s" << endl;
+  cout << fixed << setprecision(2);
+  cout << setw(8) << left << "loop" << right;
+  cout << setw(10) << Measure(LoopOr,  2, &dst[0], &a[0], &b[0], n, reps);
+  cout << setw(10) << Measure(LoopAnd, 2, &dst[0], &a[0], &b[0], n, reps);
+  cout << setw(10) << Measure(LoopNot, 1, &dst[0], &a[0], &b[0], n, reps) << endl;
+  for (int k = 0; k < 4; k++)
+  {
+    if (!BitOpsSetIsa(isas[k]))
+    {
+      cout << setw(8) << left << BitOpsIsaName(isas[k]) << right
+           << "  not supported" << endl;
+      continue;
+    }
+    cout << setw(8) << left << BitOpsIsaName(isas[k]) << right;
+    cout << setw(10) << Measure(BitOr,     2, &dst[0], &a[0], &b[0], n, reps);
+    cout << setw(10) << Measure(BitAnd,    2, &dst[0], &a[0], &b[0], n, reps);
+    cout << setw(10) << Measure(KernelNot, 1, &dst[0], &a[0], &b[0], n, reps) << endl;
+  }
+  BitOpsSetIsa(best);
+  cout << "default: " << BitOpsIsaName(best) << endl;
+  return 0;
+}
@@ -0,0 +1,72 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_concurrent.cpp
+//
+// Общее множество посещенных вершин для нескольких потоков: TestAndSet
+// TConcurrentBitField в сравнении с TBitField под мьютексом
+//   bench_concurrent [к-во битов] [к-во операций на поток] [наибольшее к-во потоков]
+
+#include "tconcurrentbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+typedef std::chrono::steady_clock TClock;
+
+static unsigned long long Next(unsigned long long &x) // xorshift
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+// к-во операций в секунду при threads потоках, каждый из которых
+// выполняет ops вызовов visit(n) для случайных n
+template <class F>
+static double Run(int threads, int ops, int bits, F visit)
+{
+  vector<std::thread> pool;
+  TClock::time_point t0 = TClock::now();
+  for (int t = 0; t < threads; t++)
+    pool.push_back(std::thread([=] {
+      unsigned long long x = 88172645463325252ull + t;
+      for (int i = 0; i < ops; i++)
+        visit((int)(Next(x) % bits));
+    }));
+  for (int t = 0; t < threads; t++)
+    pool[t].join();
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  return (double)threads * ops / sec;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1 << 20;
+  int ops = (argc > 2) ? atoi(argv[2]) : 1000000;
+  int maxThreads = (argc > 3) ? atoi(argv[3]) : 32;
+
+  cout << "bits: " << bits << ", operations per thread: " << ops << endl;
+  cout << setw(8) << "threads" << setw(20) << "mutex, Mops/s" << setw(20)
+       << "atomic, Mops/s" << endl;
+  for (int t = 1; ; t = (2 * t < maxThreads) ? 2 * t : maxThreads)
+  {
+    TBitField locked(bits);
+    std::mutex m;
+    double slow = Run(t, ops, bits, [&locked, &m](int n) {
+      std::lock_guard<std::mutex> lk(m);
+      if (!locked.GetBit(n))
+        locked.SetBit(n);
+    });
+    TConcurrentBitField shared(bits);
+    double fast = Run(t, ops, bits, [&shared](int n) { shared.TestAndSet(n); });
+    cout << setw(8) << t << fixed << setprecision(1) << setw(20) << slow / 1e6
+         << setw(20) << fast / 1e6 << endl;
+    if (t == maxThreads)
+      break;
+  }
+  return 0;
+}
@@ -0,0 +1,55 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_count.cpp
+//
+// Подсчет установленных битов: TBitField::Count для каждого набора
+// инструкций в сравнении с перебором GetBit
+//   bench_count [к-во битов]
+
+#include "tbitfield.h"
+#include "tbitops.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+typedef std::chrono::steady_clock TClock;
+
+static double Seconds(TClock::time_point t0)
+{
+  return std::chrono::duration<double>(TClock::now() - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1000000000;
+
+  TBitField bf(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+
+  cout << "bits: " << bits << endl << fixed << setprecision(2);
+
+  TClock::time_point t0 = TClock::now();
+  int count = 0;
+  for (int i = 0; i < bits; i++)
+    count += bf.GetBit(i);
+  cout << setw(8) << left << "GetBit" << right << setw(12) << count
+       << setw(10) << Seconds(t0) * 1e3 << " ms" << endl;
+
+  const TBitOpsIsa isas[] = { BITOPS_SCALAR, BITOPS_SSE2, BITOPS_AVX2, BITOPS_AVX512 };
+  TBitOpsIsa best = BitOpsGetIsa();
+  for (int k = 0; k < 4; k++)
+  {
+    if (!BitOpsSetIsa(isas[k]))
+      continue;
+    t0 = TClock::now();
+    count = bf.Count();
+    double sec = Seconds(t0);
+    cout << setw(8) << left << BitOpsIsaName(isas[k]) << right << setw(12) << count
+         << setw(10) << sec * 1e3 << " ms" << setw(10)
+         << bits / 8.0 / sec / 1e9 << " GB/s" << endl;
+  }
+  BitOpsSetIsa(best);
+  return 0;
+}
@@ -0,0 +1,122 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_expr.cpp
+//
+// Выражения из 3 и 8 операндов над битовыми полями и множествами:
+// ленивое вычисление за один проход в сравнении с построением
+// промежуточного поля на каждую операцию
+//   bench_expr [к-во битов] [к-во повторов]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+// по одному промежуточному полю на операцию
+static TBitField Field3Steps(const vector<TBitField> &v)
+{
+  TBitField t1 = v[0] | v[1];
+  TBitField t2 = ~v[2];
+  return TBitField(t1 & t2);
+}
+
+// одно выражение, вычисляемое за один проход
+static TBitField Field3Fused(const vector<TBitField> &v)
+{
+  return (v[0].Lazy() | v[1]) & ~v[2].Lazy();
+}
+
+static TBitField Field8Steps(const vector<TBitField> &v)
+{
+  TBitField t1 = v[0] | v[1];
+  TBitField t2 = ~v[2];
+  TBitField t3 = t1 & t2;
+  TBitField t4 = v[3] & v[4];
+  TBitField t5 = t3 | t4;
+  TBitField t6 = v[5] | v[6];
+  TBitField t7 = ~t6;
+  TBitField t8 = t5 & t7;
+  return TBitField(t8 | v[7]);
+}
+
+static TBitField Field8Fused(const vector<TBitField> &v)
+{
+  return ((((v[0].Lazy() | v[1]) & ~v[2].Lazy()) | (v[3].Lazy() & v[4])) &
+          ~(v[5].Lazy() | v[6])) | v[7];
+}
+
+static TSet Set3Steps(const vector<TSet> &v)
+{
+  TSet t1 = v[0] + v[1];
+  TSet t2 = ~v[2];
+  return TSet(t1 * t2);
+}
+
+static TSet Set3Fused(const vector<TSet> &v)
+{
+  return (v[0].Lazy() + v[1]) * ~v[2].Lazy();
+}
+
+static TSet Set8Steps(const vector<TSet> &v)
+{
+  TSet t1 = v[0] + v[1];
+  TSet t2 = ~v[2];
+  TSet t3 = t1 * t2;
+  TSet t4 = v[3] * v[4];
+  TSet t5 = t3 + t4;
+  TSet t6 = v[5] + v[6];
+  TSet t7 = ~t6;
+  TSet t8 = t5 * t7;
+  return TSet(t8 + v[7]);
+}
+
+static TSet Set8Fused(const vector<TSet> &v)
+{
+  return ((((v[0].Lazy() + v[1]) * ~v[2].Lazy()) + (v[3].Lazy() * v[4])) *
+          ~(v[5].Lazy() + v[6])) + v[7];
+}
+
+template <class T, class F>
+static void Measure(const char *name, F f, const vector<T> &v, int reps)
+{
+  long long sum = 0;
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+  {
+    T res = f(v);
+    sum += res == v[0];
+  }
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << name << ": " << sec / reps * 1e6 << " us" << (sum ? " *" : "") << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 200;
+
+  vector<TBitField> fields;
+  for (int k = 0; k < 8; k++)
+  {
+    TBitField bf(bits);
+    for (int i = k; i < bits; i += k + 2)
+      bf.SetBit(i);
+    fields.push_back(std::move(bf));
+  }
+  vector<TSet> sets(fields.begin(), fields.end());
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure<TBitField>("TBitField, 3 operands, step by step", Field3Steps, fields, reps);
+  Measure<TBitField>("TBitField, 3 operands, fused       ", Field3Fused, fields, reps);
+  Measure<TBitField>("TBitField, 8 operands, step by step", Field8Steps, fields, reps);
+  Measure<TBitField>("TBitField, 8 operands, fused       ", Field8Fused, fields, reps);
+  Measure<TSet>("TSet,      3 operands, step by step", Set3Steps, sets, reps);
+  Measure<TSet>("TSet,      3 operands, fused       ", Set3Fused, sets, reps);
+  Measure<TSet>("TSet,      8 operands, step by step", Set8Steps, sets, reps);
+  Measure<TSet>("TSet,      8 operands, fused       ", Set8Fused, sets, reps);
+  return 0;
+}
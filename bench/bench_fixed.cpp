@@ -0,0 +1,55 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_fixed.cpp
+//
+// Малые множества флагов: TFixedBitField<N> со встроенной памятью
+// в сравнении с TBitField той же длины
+//   bench_fixed [к-во повторов]
+
+#include "tfixedbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+typedef std::chrono::steady_clock TClock;
+
+static const int Bits = 128;
+
+static double Seconds(TClock::time_point t0)
+{
+  return std::chrono::duration<double>(TClock::now() - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+  int reps = (argc > 1) ? atoi(argv[1]) : 10000000;
+  long long sum = 0;
+
+  cout << "repetitions: " << reps << endl << fixed << setprecision(2);
+
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+  {
+    TBitField a(Bits), b(Bits);
+    a.SetBit(r % Bits);
+    b.SetBit((r * 7) % Bits);
+    sum += ((a | b) & ~a).GetBit((r * 7) % Bits);
+  }
+  cout << setw(16) << left << "TBitField" << right << setw(10)
+       << Seconds(t0) * 1e9 / reps << " ns/op" << endl;
+
+  t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+  {
+    TFixedBitField<Bits> a, b;
+    a.SetBit(r % Bits);
+    b.SetBit((r * 7) % Bits);
+    sum += ((a | b) & ~a).GetBit((r * 7) % Bits);
+  }
+  cout << setw(16) << left << "TFixedBitField" << right << setw(10)
+       << Seconds(t0) * 1e9 / reps << " ns/op" << endl;
+
+  cout << "checksum: " << sum << endl;
+  return 0;
+}
@@ -0,0 +1,96 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_input.cpp
+//
+// Ввод битового поля и множества из текстового дампа: operator>>,
+// разбирающий буфер потока, в сравнении с прежним посимвольным вводом
+// через peek/get и SetBit/InsElem
+//   bench_input [к-во битов] [к-во повторов]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+typedef std::chrono::steady_clock TClock;
+
+static void FieldPerChar(istream &istr, TBitField &bf) // прежний ввод поля
+{
+  char c;
+  int i = 0;
+  istr >> ws;
+  while ((i < bf.GetLength()) && ((c = istr.peek()) == '0' || c == '1'))
+  {
+    istr.get();
+    if (c == '1')
+      bf.SetBit(i);
+    i++;
+  }
+}
+
+static void SetPerElem(istream &istr, TSet &s) // прежний ввод множества
+{
+  int Elem;
+  char c;
+  istr >> ws;
+  if (istr.peek() == '{')
+    istr.get();
+  while ((c = (istr >> ws).peek()) != EOF)
+  {
+    if (c == ',')
+    {
+      istr.get();
+      continue;
+    }
+    if (c == '}')
+    {
+      istr.get();
+      break;
+    }
+    if (!(istr >> Elem))
+      break;
+    s.InsElem(Elem);
+  }
+}
+
+template <class T, class F>
+static void Measure(const char *name, F f, const std::string &text, T &res, int reps)
+{
+  double sec = 0;
+  for (int r = 0; r < reps; r++)
+  {
+    std::istringstream is(text);
+    TClock::time_point t0 = TClock::now();
+    f(is, res);
+    sec += std::chrono::duration<double>(TClock::now() - t0).count();
+  }
+  sec /= reps;
+  cout << name << ": " << sec * 1e3 << " ms, " << text.size() / sec / 1e6 << " MB/s" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 100000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 3;
+
+  TBitField bf(bits), bfRes(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+  TSet s(bits), sRes(bits);
+  for (int i = 0; i < bits; i += 9)
+    s.InsElem(i);
+  std::ostringstream bfText, sText;
+  bfText << bf;
+  sText << s;
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure("TBitField, per character", FieldPerChar, bfText.str(), bfRes, reps);
+  Measure("TBitField, operator>>   ", [](istream &is, TBitField &r) { is >> r; },
+          bfText.str(), bfRes, reps);
+  Measure("TSet,      per element  ", SetPerElem, sText.str(), sRes, reps);
+  Measure("TSet,      operator>>   ", [](istream &is, TSet &r) { is >> r; },
+          sText.str(), sRes, reps);
+  cout << ((bfRes == bf) && (sRes == s) ? "ok" : "mismatch") << endl;
+  return 0;
+}
@@ -0,0 +1,60 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_mapped.cpp
+//
+// Время до первого запроса и полный проход по полю из файла: чтение
+// в память (Load) в сравнении с отображением (TMappedBitField)
+//   bench_mapped [к-во битов] [имя файла]
+
+#include "tmappedbitfield.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+typedef std::chrono::steady_clock TClock;
+
+static double Since(TClock::time_point t0)
+{
+  return std::chrono::duration<double>(TClock::now() - t0).count() * 1e3;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1 << 30;
+  const char *name = (argc > 2) ? argv[2] : "bench_mapped.tmp";
+  {
+    TBitField bf(bits);
+    for (int i = 0; i < bits; i += 3)
+      bf.SetBit(i);
+    std::ofstream os(name, std::ios::binary);
+    bf.Save(os);
+  }
+  cout << "bits: " << bits << ", file: " << name << endl;
+
+  TClock::time_point t0 = TClock::now();
+  TBitField loaded(0);
+  {
+    std::ifstream is(name, std::ios::binary);
+    loaded.Load(is);
+  }
+  int b = loaded.GetBit(bits / 2);
+  cout << "Load, first query  : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  int c = loaded.Count();
+  cout << "Load, Count        : " << Since(t0) << " ms" << endl;
+
+  t0 = TClock::now();
+  TMappedBitField m(name);
+  b += m.GetBit(bits / 2);
+  cout << "mmap, first query  : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  m.Advise(TMappedBitField::Sequential);
+  c -= m.Count();
+  cout << "mmap, Count        : " << Since(t0) << " ms" << endl;
+
+  std::remove(name);
+  cout << ((c == 0) && (b % 2 == 0) ? "ok" : "MISMATCH") << endl;
+  return 0;
+}
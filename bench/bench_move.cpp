@@ -0,0 +1,160 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_move.cpp
+//
+// К-во выделений памяти и время вычисления выражений над битовыми полями
+// и множествами при копировании и при перемещении временных операндов
+//   bench_move [к-во битов] [к-во повторов]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+typedef std::chrono::steady_clock TClock;
+
+static long long AllocCount = 0; // к-во вызовов operator new
+
+void *operator new(size_t size)
+{
+  AllocCount++;
+  void *p = malloc(size ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+  free(p);
+}
+
+// выделения с выравниванием (через них работает pmr::new_delete_resource)
+void *operator new(size_t size, std::align_val_t align)
+{
+  AllocCount++;
+  size_t a = size_t(align);
+  void *p = aligned_alloc(a, (size + a - 1) / a * a);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+  return operator new(size, align);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+// выражения с явными копиями промежуточных результатов
+static TBitField FieldCopy(const TBitField &a, const TBitField &b,
+                           const TBitField &c, const TBitField &d)
+{
+  TBitField t1 = a | b;
+  TBitField t2 = t1 & c;
+  TBitField t3 = ~t2;
+  return t3 | d;
+}
+
+// то же выражение с временными операндами
+static TBitField FieldMove(const TBitField &a, const TBitField &b,
+                           const TBitField &c, const TBitField &d)
+{
+  return ~((a | b) & c) | d;
+}
+
+static TSet SetCopy(const TSet &a, const TSet &b, const TSet &c, const TSet &d)
+{
+  TSet t1 = a + b;
+  TSet t2 = t1 * c;
+  TSet t3 = ~t2;
+  TSet t4 = t3 + d;
+  return t4 + 1;
+}
+
+static TSet SetMove(const TSet &a, const TSet &b, const TSet &c, const TSet &d)
+{
+  return (~((a + b) * c) + d) + 1;
+}
+
+template <class T, class F>
+static void Measure(const char *name, F f, const T &a, const T &b, const T &c,
+                    const T &d, int reps)
+{
+  long long allocs = AllocCount;
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+  {
+    T res = f(a, b, c, d);
+    if (res != res)
+      cout << "unreachable" << endl;
+  }
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << name << ": " << double(AllocCount - allocs) / reps
+       << " allocations per expression, " << sec / reps * 1e6 << " us" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 200;
+
+  TBitField a(bits), b(bits), c(bits), d(bits);
+  for (int i = 0; i < bits; i += 3)
+    a.SetBit(i);
+  for (int i = 0; i < bits; i += 5)
+    b.SetBit(i);
+  for (int i = 0; i < bits; i += 7)
+    c.SetBit(i);
+  for (int i = 0; i < bits; i += 11)
+    d.SetBit(i);
+  TSet sa(a), sb(b), sc(c), sd(d);
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure<TBitField>("TBitField ~((a | b) & c) | d, copies     ", FieldCopy, a, b, c, d, reps);
+  Measure<TBitField>("TBitField ~((a | b) & c) | d, temporaries", FieldMove, a, b, c, d, reps);
+  Measure<TSet>("TSet (~((a + b) * c) + d) + 1, copies     ", SetCopy, sa, sb, sc, sd, reps);
+  Measure<TSet>("TSet (~((a + b) * c) + d) + 1, temporaries", SetMove, sa, sb, sc, sd, reps);
+  return 0;
+}
@@ -0,0 +1,84 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_multiway.cpp
+//
+// Объединение и пересечение k множеств: цепочка попарных операций
+// в сравнении с UnionAll/IntersectAll, проходящими входы поблочно
+//   bench_multiway [к-во битов] [к-во повторов]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+static TSet UnionPairwise(const vector<const TSet*> &p)
+{
+  TSet res(*p[0]);
+  for (size_t j = 1; j < p.size(); j++)
+    res = res + *p[j];
+  return res;
+}
+
+static TSet UnionMulti(const vector<const TSet*> &p)
+{
+  return TSet::UnionAll(p.data(), (int)p.size());
+}
+
+static TSet IntersectPairwise(const vector<const TSet*> &p)
+{
+  TSet res(*p[0]);
+  for (size_t j = 1; j < p.size(); j++)
+    res = res * *p[j];
+  return res;
+}
+
+static TSet IntersectMulti(const vector<const TSet*> &p)
+{
+  return TSet::IntersectAll(p.data(), (int)p.size());
+}
+
+template <class F>
+static void Measure(const char *name, F f, const vector<const TSet*> &p, int bits, int reps)
+{
+  long long sum = 0;
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    sum += f(p).Cardinality();
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count() / reps;
+  double bytes = (double)bits / 8 * p.size();
+  cout << name << ", k = " << p.size() << ": " << sec * 1e6 << " us, "
+       << bytes / sec / 1e9 << " GB/s" << (sum ? " *" : "") << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 20;
+
+  vector<TSet> sets;
+  for (int k = 0; k < 256; k++)
+  {
+    TSet s(bits);
+    for (int i = k % 7; i < bits; i += 2)
+      s.InsElem(i);
+    sets.push_back(std::move(s));
+  }
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  const int ks[] = { 8, 64, 256 };
+  for (int k : ks)
+  {
+    vector<const TSet*> p;
+    for (int j = 0; j < k; j++)
+      p.push_back(&sets[j]);
+    Measure("union,        pairwise", UnionPairwise, p, bits, reps);
+    Measure("union,        UnionAll", UnionMulti, p, bits, reps);
+    Measure("intersection, pairwise", IntersectPairwise, p, bits, reps);
+    Measure("intersection, IntersectAll", IntersectMulti, p, bits, reps);
+  }
+  return 0;
+}
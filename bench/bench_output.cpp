@@ -0,0 +1,77 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_output.cpp
+//
+// Вывод битового поля и множества в поток: буферизованный operator<<
+// в сравнении с посимвольным/поэлементным выводом через ostream
+//   bench_output [к-во битов] [к-во повторов]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <streambuf>
+
+typedef std::chrono::steady_clock TClock;
+
+// поток, отбрасывающий вывод: измеряется только форматирование
+class TNullBuf : public std::streambuf
+{
+public:
+  long long Size = 0;
+protected:
+  int overflow(int c) override { Size++; return c; }
+  std::streamsize xsputn(const char *, std::streamsize n) override { Size += n; return n; }
+};
+
+static void FieldPerChar(ostream &ostr, const TBitField &bf) // прежний вывод поля
+{
+  for (int i = 0; i < bf.GetLength(); i++)
+    ostr << (bf.GetBit(i) ? '1' : '0');
+}
+
+static void SetPerElem(ostream &ostr, const TSet &s) // прежний вывод множества
+{
+  int first = 1;
+  ostr << '{';
+  for (int e : s)
+  {
+    if (!first)
+      ostr << ", ";
+    ostr << e;
+    first = 0;
+  }
+  ostr << '}';
+}
+
+template <class F>
+static void Measure(const char *name, F f, int reps)
+{
+  TNullBuf nb;
+  ostream os(&nb);
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    f(os);
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count() / reps;
+  cout << name << ": " << sec * 1e3 << " ms, " << nb.Size / reps / sec / 1e6 << " MB/s" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 100000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 3;
+
+  TBitField bf(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+  TSet s(bits);
+  for (int i = 0; i < bits; i += 17)
+    s.InsElem(i);
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure("TBitField, per character", [&](ostream &os) { FieldPerChar(os, bf); }, reps);
+  Measure("TBitField, operator<<   ", [&](ostream &os) { os << bf; }, reps);
+  Measure("TSet,      per element  ", [&](ostream &os) { SetPerElem(os, s); }, reps);
+  Measure("TSet,      operator<<   ", [&](ostream &os) { os << s; }, reps);
+  return 0;
+}
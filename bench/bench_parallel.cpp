@@ -0,0 +1,77 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_parallel.cpp
+//
+// Операции над длинным битовым полем при разном к-ве потоков пула:
+// время и ускорение относительно одного потока
+//   bench_parallel [к-во битов] [к-во повторов] [наибольшее к-во потоков]
+
+#include "tbitfield.h"
+#include "tbitops.h"
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <thread>
+
+typedef std::chrono::steady_clock TClock;
+
+template <class F>
+static double Measure(F f, int reps) // секунд на повтор
+{
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    f();
+  return std::chrono::duration<double>(TClock::now() - t0).count() / reps;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : INT_MAX;
+  int reps = (argc > 2) ? atoi(argv[2]) : 5;
+  int maxThreads = (argc > 3) ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+  if (maxThreads < 1)
+    maxThreads = 1;
+
+  TBitField a(bits), b(bits), res(bits);
+  for (int i = 0; i < bits; i += 3)
+    a.SetBit(i);
+  for (int i = 0; i < bits; i += 5)
+    b.SetBit(i);
+  TBitField c(a); // равные поля сравниваются до конца
+
+  const char *names[] = { "|", "&", "~", "==", "Count" };
+  const int ops = 5;
+  double base[ops];
+  long long sum = 0;
+
+  cout << "bits: " << bits << " (" << bits / 8 / (1 << 20) << " MiB), repetitions: "
+       << reps << endl;
+  cout << setw(8) << "threads";
+  for (int k = 0; k < ops; k++)
+    cout << setw(19) << names[k];
+  cout << endl;
+  for (int t = 1; ; t = (2 * t < maxThreads) ? 2 * t : maxThreads)
+  {
+    BitOpsSetThreads(t);
+    double sec[ops];
+    sec[0] = Measure([&] { res = a | b; }, reps);
+    sec[1] = Measure([&] { res = a & b; }, reps);
+    sec[2] = Measure([&] { res = ~a; }, reps);
+    sec[3] = Measure([&] { sum += (c == a); }, reps);
+    sec[4] = Measure([&] { sum += a.Count(); }, reps);
+    cout << setw(8) << t << fixed << setprecision(2);
+    for (int k = 0; k < ops; k++)
+    {
+      if (t == 1)
+        base[k] = sec[k];
+      cout << setw(10) << sec[k] * 1e3 << " ms x" << setw(4) << base[k] / sec[k];
+    }
+    cout << endl;
+    if (t == maxThreads) // последней строкой - наибольшее к-во потоков
+      break;
+  }
+  cout << "checksum: " << sum << endl;
+  return 0;
+}
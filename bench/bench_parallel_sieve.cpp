@@ -0,0 +1,42 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_parallel_sieve.cpp
+//
+// Подсчет простых чисел до n параллельным решетом TPrimeSieve на 1..N
+// потоках: время и ускорение относительно одного потока
+//   bench_parallel_sieve [n] [наибольшее к-во потоков]
+
+#include "tprimesieve.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <thread>
+
+typedef std::chrono::steady_clock TClock;
+
+int main(int argc, char **argv)
+{
+  long long n = (argc > 1) ? atoll(argv[1]) : 10000000000ll;
+  int maxThreads = (argc > 2) ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+  if (maxThreads < 1)
+    maxThreads = 1;
+
+  cout << "n: " << n << endl;
+  cout << setw(8) << "threads" << setw(14) << "primes" << setw(12) << "time, s"
+       << setw(10) << "speedup" << endl;
+  double base = 0;
+  for (int t = 1; ; t = (2 * t < maxThreads) ? 2 * t : maxThreads)
+  {
+    TClock::time_point t0 = TClock::now();
+    long long cnt = TPrimeSieve::CountPrimes(0, n, t);
+    double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+    if (t == 1)
+      base = sec;
+    cout << setw(8) << t << setw(14) << cnt << fixed << setprecision(3) << setw(12) << sec
+         << setprecision(2) << setw(10) << base / sec << endl;
+    if (t == maxThreads)
+      break;
+  }
+  return 0;
+}
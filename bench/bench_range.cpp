@@ -0,0 +1,57 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_range.cpp
+//
+// Установка, инвертирование и проверка диапазона битов: операции над
+// диапазоном в сравнении с поразрядными SetBit/GetBit
+//   bench_range [к-во битов]
+
+#include "tbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock TClock;
+
+static double Since(TClock::time_point t0)
+{
+  return std::chrono::duration<double>(TClock::now() - t0).count() * 1e3;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1000000000;
+  TBitField bf(bits);
+  int lo = 3, hi = bits - 5;
+  cout << "bits: " << bits << endl;
+
+  TClock::time_point t0 = TClock::now();
+  for (int i = lo; i < hi; i++)
+    bf.SetBit(i);
+  cout << "SetBit per bit: " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  int all = 1;
+  for (int i = lo; (i < hi) && all; i++)
+    all = bf.GetBit(i);
+  cout << "GetBit per bit: " << Since(t0) << " ms" << endl;
+
+  bf.ClrRange(0, bits);
+  t0 = TClock::now();
+  bf.SetRange(lo, hi);
+  cout << "SetRange      : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  all &= bf.AllInRange(lo, hi);
+  cout << "AllInRange    : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  bf.FlipRange(lo, hi);
+  cout << "FlipRange     : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  int any = bf.AnyInRange(0, bits);
+  cout << "AnyInRange    : " << Since(t0) << " ms" << endl;
+  t0 = TClock::now();
+  bf.ClrRange(lo, hi);
+  cout << "ClrRange      : " << Since(t0) << " ms" << endl;
+
+  cout << (all && !any ? "ok" : "MISMATCH") << endl;
+  return 0;
+}
@@ -0,0 +1,66 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_serialize.cpp
+//
+// Двоичная запись и чтение битового поля в сравнении с копированием
+// памяти (memcpy) и текстовым вводом/выводом
+//   bench_serialize [к-во битов] [к-во повторов]
+
+#include "tbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+template <class F>
+static void Measure(const char *name, F f, size_t bytes, int reps)
+{
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    f();
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count() / reps;
+  cout << name << ": " << sec * 1e3 << " ms, " << bytes / sec / 1e9 << " GB/s" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 1 << 30;
+  int reps = (argc > 2) ? atoi(argv[2]) : 5;
+
+  TBitField bf(bits), res(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+  size_t bytes = (bits + 7) / 8;
+  vector<char> buf(bf.SaveSize()), src(bytes, 1), dst(bytes);
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure("memcpy             ", [&] { memcpy(dst.data(), src.data(), bytes); }, bytes, reps);
+  Measure("Save to buffer     ", [&] { bf.Save(buf.data(), buf.size()); }, bytes, reps);
+  Measure("Load from buffer   ", [&] { res.Load(buf.data(), buf.size()); }, bytes, reps);
+  std::string data;
+  Measure("Save to stream     ", [&] {
+    std::ostringstream os;
+    bf.Save(os);
+    data = os.str();
+  }, bytes, reps);
+  Measure("Load from stream   ", [&] {
+    std::istringstream is(data);
+    res.Load(is);
+  }, bytes, reps);
+  int textReps = (reps > 1) ? 1 : reps;
+  Measure("text output (<<)   ", [&] {
+    std::ostringstream os;
+    os << bf;
+    data = os.str();
+  }, bytes, textReps);
+  Measure("text input (>>)    ", [&] {
+    std::istringstream is(data);
+    is >> res;
+  }, bytes, textReps);
+  cout << (res == bf ? "ok" : "MISMATCH") << endl;
+  return 0;
+}
@@ -0,0 +1,55 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_shift.cpp
+//
+// Сдвиги и циклические сдвиги битового поля в сравнении с копированием
+// его памяти (memcpy) и поразрядным сдвигом
+//   bench_shift [к-во битов] [к-во повторов]
+
+#include "tbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef std::chrono::steady_clock TClock;
+
+template <class F>
+static void Measure(const char *name, F f, int reps)
+{
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    f();
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << name << ": " << sec / reps * 1e3 << " ms" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 100000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 10;
+
+  TBitField bf(bits), res(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+  size_t bytes = (bits + 7) / 8;
+  vector<char> src(bytes, 1), dst(bytes);
+
+  cout << "bits: " << bits << ", repetitions: " << reps << endl;
+  Measure("memcpy           ", [&] { memcpy(dst.data(), src.data(), bytes); }, reps);
+  Measure("bf << 37         ", [&] { res = bf << 37; }, reps);
+  Measure("bf >> 37         ", [&] { res = bf >> 37; }, reps);
+  Measure("ShiftLeft(37)    ", [&] { res.ShiftLeft(37); }, reps);
+  Measure("ShiftRight(37)   ", [&] { res.ShiftRight(37); }, reps);
+  Measure("ShiftLeft(64)    ", [&] { res.ShiftLeft(64); }, reps);
+  Measure("RotateLeft(37)   ", [&] { res.RotateLeft(37); }, reps);
+  Measure("bit by bit << 37 ", [&] {
+    for (int i = bits - 1; i >= 37; i--)
+      if (res.GetBit(i - 37))
+        res.SetBit(i);
+      else
+        res.ClrBit(i);
+  }, 1);
+  return 0;
+}
@@ -0,0 +1,59 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_sieve.cpp
+//
+// Подсчет простых чисел до n: решето на одном битовом поле длины n + 1
+// (как в sample_prime_numbers до появления TPrimeSieve) в сравнении
+// с сегментированным решетом TPrimeSieve
+//   bench_sieve [наибольшее n для простого решета] [наибольшее n]
+
+#include "tprimesieve.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+typedef std::chrono::steady_clock TClock;
+
+static long long SimpleCount(int n) // решето на одном поле
+{
+  TBitField s(n + 1);
+  for (int m = 2; m <= n; m++)
+    s.SetBit(m);
+  for (int m = 2; (long long)m * m <= n; m++)
+    if (s.GetBit(m))
+      for (int k = 2 * m; k <= n; k += m)
+        s.ClrBit(k);
+  return s.Count();
+}
+
+template <class F>
+static double Seconds(F f, long long &res)
+{
+  TClock::time_point t0 = TClock::now();
+  res = f();
+  return std::chrono::duration<double>(TClock::now() - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+  long long simpleMax = (argc > 1) ? atoll(argv[1]) : 1000000000ll;
+  long long maxN = (argc > 2) ? atoll(argv[2]) : 10000000000ll;
+
+  cout << setw(14) << "n" << setw(14) << "primes" << setw(14) << "simple, s"
+       << setw(14) << "segmented, s" << endl;
+  for (long long n = 1000000; n <= maxN; n *= 10)
+  {
+    long long cnt, simple = -1;
+    double ts = 0, tp = Seconds([n] { return TPrimeSieve::CountPrimes(n); }, cnt);
+    if (n <= simpleMax)
+      ts = Seconds([n] { return SimpleCount((int)n); }, simple);
+    cout << setw(14) << n << setw(14) << cnt << fixed << setprecision(3);
+    if (simple >= 0)
+      cout << setw(14) << ts;
+    else
+      cout << setw(14) << "-";
+    cout << setw(14) << tp << (((simple >= 0) && (simple != cnt)) ? " mismatch" : "") << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,119 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_smallset.cpp
+//
+// Множество короткоживущих множеств малой мощности: к-во выделений памяти
+// и время для мощности в пределах встроенной памяти TBitField и за ними
+//   bench_smallset [к-во множеств]
+
+#include "tset.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+typedef std::chrono::steady_clock TClock;
+
+static long long AllocCount = 0; // к-во вызовов operator new
+
+void *operator new(size_t size)
+{
+  AllocCount++;
+  void *p = malloc(size ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+  free(p);
+}
+
+// выделения с выравниванием (через них работает pmr::new_delete_resource)
+void *operator new(size_t size, std::align_val_t align)
+{
+  AllocCount++;
+  size_t a = size_t(align);
+  void *p = aligned_alloc(a, (size + a - 1) / a * a);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+  return operator new(size, align);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+// создание, копирование, объединение и уничтожение count множеств
+static void Run(int mp, int count)
+{
+  long long allocs = AllocCount, sum = 0;
+  TClock::time_point t0 = TClock::now();
+  for (int i = 0; i < count; i++)
+  {
+    TSet s(mp);
+    s.InsElem(i % mp);
+    s.InsElem((i * 7) % mp);
+    TSet t(s);
+    t.InsElem((i * 13) % mp);
+    sum += (s + t).Cardinality();
+  }
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << "TSet(" << mp << "): " << double(AllocCount - allocs) / count
+       << " allocations per set, " << sec * 1e3 << " ms (checksum " << sum
+       << ")" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+  cout << "sets: " << count << endl;
+  Run(64, count);
+  Run(256, count);
+  Run(257, count);
+  Run(1024, count);
+  return 0;
+}
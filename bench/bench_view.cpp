@@ -0,0 +1,55 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_view.cpp
+//
+// Работа с окном большого битового поля: представление TBitFieldView
+// и Extract в сравнении с поразрядным копированием окна в новое поле
+//   bench_view [к-во битов] [к-во повторов]
+
+#include "tbitfieldview.h"
+
+#include <chrono>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock TClock;
+
+template <class F>
+static void Measure(const char *name, F f, int reps)
+{
+  TClock::time_point t0 = TClock::now();
+  for (int r = 0; r < reps; r++)
+    f();
+  double sec = std::chrono::duration<double>(TClock::now() - t0).count();
+  cout << name << ": " << sec / reps * 1e3 << " ms" << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 100000000;
+  int reps = (argc > 2) ? atoi(argv[2]) : 10;
+
+  TBitField bf(bits);
+  for (int i = 0; i < bits; i += 3)
+    bf.SetBit(i);
+  int lo = 13, hi = lo + bits / 2; // окно с невыровненным началом
+  TBitFieldView a(bf, lo, hi), b(bf, hi - lo / 2, bits - lo / 2 - 1);
+  long long sum = 0;
+
+  cout << "bits: " << bits << ", window: " << hi - lo << ", repetitions: " << reps << endl;
+  Measure("copy bit by bit  ", [&] {
+    TBitField w(hi - lo);
+    for (int i = lo; i < hi; i++)
+      if (bf.GetBit(i))
+        w.SetBit(i - lo);
+    sum += w.Count();
+  }, 1);
+  Measure("Extract          ", [&] { sum += bf.Extract(lo, hi).Count(); }, reps);
+  Measure("view Count       ", [&] { sum += a.Count(); }, reps);
+  Measure("Extract, x & y   ", [&] {
+    TBitField x = a.Extract(), y = b.Extract();
+    sum += TBitField(x & y).Count();
+  }, reps);
+  Measure("view & view      ", [&] { sum += (a & b).Count(); }, reps);
+  cout << (sum ? "" : "*") << endl;
+  return 0;
+}
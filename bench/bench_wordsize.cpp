@@ -0,0 +1,59 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// bench_wordsize.cpp
+//
+// Влияние размера слова битового поля (32/64/128 битов) на скорость
+// поиска и перебора установленных битов и поразрядных операций
+//   bench_wordsize [к-во битов] [шаг установленных битов]
+
+#include "tbitfield.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+typedef std::chrono::steady_clock TClock;
+
+static double Seconds(TClock::time_point t0)
+{
+  return std::chrono::duration<double>(TClock::now() - t0).count();
+}
+
+template <class TField>
+static void Run(const char *name, int bits, int step)
+{
+  TField a(bits), b(bits);
+  for (int i = 0; i < bits; i += step)
+    a.SetBit(i);
+  for (int i = step / 2; i < bits; i += step)
+    b.SetBit(i);
+
+  TClock::time_point t0 = TClock::now();
+  long long sum = 0;
+  for (int n : a)
+    sum += n;
+  double iter = Seconds(t0);
+
+  t0 = TClock::now();
+  TField c = a | b;
+  c &= ~b;
+  double ops = Seconds(t0);
+
+  cout << setw(8) << left << name << right << setw(12) << iter * 1e3
+       << setw(12) << ops * 1e3 << setw(14) << sum % 1000 + c.Count() << endl;
+}
+
+int main(int argc, char **argv)
+{
+  int bits = (argc > 1) ? atoi(argv[1]) : 256 * 1024 * 1024;
+  int step = (argc > 2) ? atoi(argv[2]) : 1000;
+
+  cout << "bits: " << bits << ", step: " << step << endl << fixed << setprecision(2);
+  cout << "word     iterate ms      ops ms      checksum" << endl;
+  Run<TBitField>("32", bits, step);
+  Run<TBitField64>("64", bits, step);
+#ifdef __SIZEOF_INT128__
+  Run<TBitField128>("128", bits, step);
+#endif
+  return 0;
+}
@@ -0,0 +1,316 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tbitexpr.h
+//
+// Ленивые выражения над битовыми полями
+//   выражение начинается с TBasicBitField::Lazy(); операции "|", "&", "~"
+//   над выражениями строят дерево узлов, которое вычисляется одним проходом
+//   по словам при преобразовании в TBasicBitField; подключается из tbitfield.h
+
+#ifndef __BITEXPR_H__
+#define __BITEXPR_H__
+
+#include "tbitfield.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Каждый узел предоставляет:
+//   Length()     - длина результата в битах;
+//   Word(i)      - i-е слово результата (за пределами длины - 0);
+//   Full()       - к-во начальных слов, для которых Word(i) == FullWord(i);
+//   FullWord(i)  - i-е слово без проверок границ и маскирования хвоста,
+//                  поэтому основной цикл вычисления не содержит ветвлений;
+//   Resource()   - источник памяти для результата.
+
+// лист - битовое поле-операнд
+template <class TWord>
+class TBitLeaf
+{
+private:
+  const TWord *pMem;
+  int BitLen, MemLen;
+  pmr::memory_resource *pRes;
+public:
+  typedef TWord TElem;
+
+  TBitLeaf(const TBasicBitField<TWord> &bf)
+    : pMem(bf.pMem), BitLen(bf.BitLen), MemLen(bf.MemLen), pRes(bf.pRes) {}
+  int Length(void) const { return BitLen; }
+  int Full(void) const { return MemLen; }
+  TWord Word(const int i) const { return (i < MemLen) ? pMem[i] : 0; }
+  TWord FullWord(const int i) const { return pMem[i]; }
+  pmr::memory_resource *Resource(void) const { return pRes; }
+};
+
+// "или": длина - большая из длин, недостающие биты считаются нулевыми
+template <class L, class R>
+class TBitOrNode
+{
+  static_assert(is_same<typename L::TElem, typename R::TElem>::value,
+                "operands must have the same word type");
+private:
+  L Left;
+  R Right;
+public:
+  typedef typename L::TElem TElem;
+
+  TBitOrNode(const L &l, const R &r) : Left(l), Right(r) {}
+  int Length(void) const
+  {
+    return (Left.Length() > Right.Length()) ? Left.Length() : Right.Length();
+  }
+  int Full(void) const { return (Left.Full() < Right.Full()) ? Left.Full() : Right.Full(); }
+  TElem Word(const int i) const { return Left.Word(i) | Right.Word(i); }
+  TElem FullWord(const int i) const { return Left.FullWord(i) | Right.FullWord(i); }
+  pmr::memory_resource *Resource(void) const { return Left.Resource(); }
+};
+
+// "и": длина - большая из длин
+template <class L, class R>
+class TBitAndNode
+{
+  static_assert(is_same<typename L::TElem, typename R::TElem>::value,
+                "operands must have the same word type");
+private:
+  L Left;
+  R Right;
+public:
+  typedef typename L::TElem TElem;
+
+  TBitAndNode(const L &l, const R &r) : Left(l), Right(r) {}
+  int Length(void) const
+  {
+    return (Left.Length() > Right.Length()) ? Left.Length() : Right.Length();
+  }
+  int Full(void) const { return (Left.Full() < Right.Full()) ? Left.Full() : Right.Full(); }
+  TElem Word(const int i) const { return Left.Word(i) & Right.Word(i); }
+  TElem FullWord(const int i) const { return Left.FullWord(i) & Right.FullWord(i); }
+  pmr::memory_resource *Resource(void) const { return Left.Resource(); }
+};
+
+// отрицание: длина операнда, биты за ее пределами остаются нулевыми
+template <class A>
+class TBitNotNode
+{
+public:
+  typedef typename A::TElem TElem;
+private:
+  static const int BitsInElem = sizeof(TElem) * 8;
+
+  A Arg;
+  int BitLen, MemLen;
+  TElem TailMask; // допустимые биты последнего слова
+public:
+  TBitNotNode(const A &a) : Arg(a), BitLen(a.Length())
+  {
+    MemLen = (BitLen + BitsInElem - 1) / BitsInElem;
+    TailMask = (BitLen % BitsInElem) ? (TElem(1) << (BitLen % BitsInElem)) - 1 : ~TElem(0);
+  }
+  int Length(void) const { return BitLen; }
+  int Full(void) const
+  {
+    int n = (BitLen % BitsInElem) ? MemLen - 1 : MemLen;
+    return (Arg.Full() < n) ? Arg.Full() : n;
+  }
+  TElem Word(const int i) const
+  {
+    if (i >= MemLen)
+      return 0;
+    return (i == MemLen - 1) ? ~Arg.Word(i) & TailMask : ~Arg.Word(i);
+  }
+  TElem FullWord(const int i) const { return ~Arg.FullWord(i); }
+  pmr::memory_resource *Resource(void) const { return Arg.Resource(); }
+};
+
+// выражение - обертка над корнем дерева; кроме преобразования в битовое
+// поле поддерживает запросы, вычисляемые без построения результата
+template <class E>
+class TBitExpr
+{
+public:
+  typedef typename E::TElem TElem;
+
+  E Node; // корень дерева
+
+  explicit TBitExpr(const E &e) : Node(e) {}
+  int GetLength(void) const { return Node.Length(); } // длина результата
+  int GetBit(const int n) const                       // значение бита результата
+  {
+    if ((n < 0) || (n >= Node.Length()))
+      throw out_of_range("bit index out of range");
+    const int bits = sizeof(TElem) * 8;
+    return (Node.Word(n / bits) >> (n % bits)) & 1;
+  }
+  int Count(void) const                               // к-во установленных битов
+  {
+    const int bits = sizeof(TElem) * 8;
+    int n = (Node.Length() + bits - 1) / bits, full = Node.Full(), res = 0, i = 0;
+    for (; i < full; i++)
+      res += BitPopcount(Node.FullWord(i));
+    for (; i < n; i++)
+      res += BitPopcount(Node.Word(i));
+    return res;
+  }
+};
+
+// операции над выражениями и битовыми полями
+
+template <class E1, class E2>
+inline TBitExpr<TBitOrNode<E1, E2> > operator|(const TBitExpr<E1> &a, const TBitExpr<E2> &b)
+{
+  return TBitExpr<TBitOrNode<E1, E2> >(TBitOrNode<E1, E2>(a.Node, b.Node));
+}
+
+template <class E, class TWord>
+inline TBitExpr<TBitOrNode<E, TBitLeaf<TWord> > >
+operator|(const TBitExpr<E> &a, const TBasicBitField<TWord> &b)
+{
+  return TBitExpr<TBitOrNode<E, TBitLeaf<TWord> > >(
+    TBitOrNode<E, TBitLeaf<TWord> >(a.Node, b));
+}
+
+template <class TWord, class E>
+inline TBitExpr<TBitOrNode<TBitLeaf<TWord>, E> >
+operator|(const TBasicBitField<TWord> &a, const TBitExpr<E> &b)
+{
+  return TBitExpr<TBitOrNode<TBitLeaf<TWord>, E> >(
+    TBitOrNode<TBitLeaf<TWord>, E>(a, b.Node));
+}
+
+// временное поле разрушится раньше, чем будет вычислено выражение
+template <class E, class TWord>
+void operator|(const TBitExpr<E> &a, TBasicBitField<TWord> &&b) = delete;
+template <class TWord, class E>
+void operator|(TBasicBitField<TWord> &&a, const TBitExpr<E> &b) = delete;
+
+template <class E1, class E2>
+inline TBitExpr<TBitAndNode<E1, E2> > operator&(const TBitExpr<E1> &a, const TBitExpr<E2> &b)
+{
+  return TBitExpr<TBitAndNode<E1, E2> >(TBitAndNode<E1, E2>(a.Node, b.Node));
+}
+
+template <class E, class TWord>
+inline TBitExpr<TBitAndNode<E, TBitLeaf<TWord> > >
+operator&(const TBitExpr<E> &a, const TBasicBitField<TWord> &b)
+{
+  return TBitExpr<TBitAndNode<E, TBitLeaf<TWord> > >(
+    TBitAndNode<E, TBitLeaf<TWord> >(a.Node, b));
+}
+
+template <class TWord, class E>
+inline TBitExpr<TBitAndNode<TBitLeaf<TWord>, E> >
+operator&(const TBasicBitField<TWord> &a, const TBitExpr<E> &b)
+{
+  return TBitExpr<TBitAndNode<TBitLeaf<TWord>, E> >(
+    TBitAndNode<TBitLeaf<TWord>, E>(a, b.Node));
+}
+
+// временное поле разрушится раньше, чем будет вычислено выражение
+template <class E, class TWord>
+void operator&(const TBitExpr<E> &a, TBasicBitField<TWord> &&b) = delete;
+template <class TWord, class E>
+void operator&(TBasicBitField<TWord> &&a, const TBitExpr<E> &b) = delete;
+
+template <class E>
+inline TBitExpr<TBitNotNode<E> > operator~(const TBitExpr<E> &a)
+{
+  return TBitExpr<TBitNotNode<E> >(TBitNotNode<E>(a.Node));
+}
+
+template <class E, class TWord>
+inline int operator==(const TBitExpr<E> &a, const TBasicBitField<TWord> &b)
+{
+  return b == a;
+}
+
+template <class E, class TWord>
+inline int operator!=(const TBitExpr<E> &a, const TBasicBitField<TWord> &b)
+{
+  return b != a;
+}
+
+template <class E>
+inline ostream &operator<<(ostream &ostr, const TBitExpr<E> &e)
+{
+  return ostr << TBasicBitField<typename E::TElem>(e);
+}
+
+// методы TBasicBitField, строящие и вычисляющие выражения
+
+template <class TWord>
+inline TBitExpr<TBitLeaf<TWord> > TBasicBitField<TWord>::Lazy(void) const &
+{
+  return TBitExpr<TLeaf>(TLeaf(*this));
+}
+
+// вычисление слов выражения с байта lo по байт hi результата; длинные
+// результаты делятся на части, вычисляемые потоками пула (tbitops.h)
+template <class E>
+struct TBitEvalArgs
+{
+  const E *Expr;
+  typename E::TElem *Mem;
+  int Full;
+};
+
+template <class E>
+void BitEvalPart(size_t lo, size_t hi, void *ctx)
+{
+  typedef typename E::TElem TElem;
+  const TBitEvalArgs<E> *p = (const TBitEvalArgs<E> *)ctx;
+  int i = int(lo / sizeof(TElem)), end = int(hi / sizeof(TElem));
+  int full = (p->Full < end) ? p->Full : end;
+  for (; i < full; i++)
+    p->Mem[i] = p->Expr->FullWord(i);
+  for (; i < end; i++)
+    p->Mem[i] = p->Expr->Word(i);
+}
+
+template <class TWord>
+template <class E>
+void TBasicBitField<TWord>::Eval(const E &e)
+{
+  Changes++;
+  TBitEvalArgs<E> args = { &e, pMem, e.Full() };
+  BitParallelFor(size_t(MemLen) * sizeof(TWord), BitEvalPart<E>, &args);
+}
+
+template <class TWord>
+template <class E>
+TBasicBitField<TWord>::TBasicBitField(const TBitExpr<E> &e)
+{
+  static_assert(is_same<typename E::TElem, TWord>::value,
+                "expression must have the same word type");
+  Changes = 0;
+  pRes = e.Node.Resource();
+  BitLen = e.Node.Length();
+  MemLen = (BitLen + BitsInElem - 1) / BitsInElem;
+  pMem = Allocate(MemLen);
+  Eval(e.Node);
+}
+
+template <class TWord>
+template <class E>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator=(const TBitExpr<E> &e)
+{
+  static_assert(is_same<typename E::TElem, TWord>::value,
+                "expression must have the same word type");
+  int len = e.Node.Length();
+  if ((len + BitsInElem - 1) / BitsInElem != MemLen)
+  {
+    TBasicBitField res(0, pRes);
+    res.Resize(len); // все слова записываются вычислением, без обнуления
+    res.Eval(e.Node);
+    return *this = std::move(res);
+  }
+  // каждое слово результата зависит только от слов операндов с тем же
+  // индексом, поэтому поле может входить в выражение
+  BitLen = len;
+  Eval(e.Node);
+  return *this;
+}
+
+#endif
@@ -8,48 +8,237 @@
 #ifndef __BITFIELD_H__
 #define __BITFIELD_H__
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
 
 using namespace std;
 
-typedef unsigned int TELEM;
+typedef unsigned int TELEM; // слово битового поля по умолчанию
 
-class TBitField
+template <class TWord> class TBasicBitIterator;
+class TSet;
+
+// узлы ленивых выражений (tbitexpr.h)
+template <class TWord> class TBitLeaf;
+template <class E> class TBitExpr;
+
+// битовое поле над словами типа TWord: unsigned int, unsigned long long
+// или unsigned __int128 (при поддержке компилятором); чем шире слово,
+// тем меньше итераций у поэлементных циклов
+template <class TWord>
+class TBasicBitField
 {
 private:
+  static const int BitsInElem = sizeof(TWord) * 8; // к-во битов в эл-те Мем
+  // поля до LocalBits битов хранятся во встроенном массиве Local,
+  // без выделения памяти из кучи
+  static const int LocalBits = 256;
+  static const int LocalLen = LocalBits / BitsInElem;
+
   int  BitLen; // длина битового поля - макс. к-во битов
-  TELEM *pMem; // память для представления битового поля
+  TWord *pMem; // память для представления битового поля (Local или pRes)
   int  MemLen; // к-во эл-тов Мем для представления бит.поля
+  TWord Local[LocalLen];       // встроенная память коротких полей
+  pmr::memory_resource *pRes;  // источник памяти длинных полей
+  unsigned Changes;            // счетчик изменений (актуальность индексов поля)
 
   // методы реализации
   int   GetMemIndex(const int n) const; // индекс в pМем для бита n       (#О2)
-  TELEM GetMemMask (const int n) const; // битовая маска для бита n       (#О3)
+  TWord GetMemMask (const int n) const; // битовая маска для бита n       (#О3)
+  void  ClearTail(void);                // обнулить биты за пределами BitLen
+  TWord *Allocate(const int n);         // память для n эл-тов (Local или pRes)
+  void  Release(void);                  // вернуть память в pRes
+  void  Steal(TBasicBitField &bf);      // перенять память bf, bf становится пустым
+  void  Resize(const int len);          // новая длина, значения слов не определены
+  // слова first..last диапазона битов lo..hi-1 и маски его битов в крайних
+  // словах; 0 для пустого диапазона, исключение при выходе за пределы поля
+  int   RangeWords(const int lo, const int hi, int &first, int &last,
+                   TWord &head, TWord &tail) const;
+  // n слов dst - биты src (srcLen слов), начиная с бита off < BitsInElem
+  // первого слова; слова за пределами src считаются нулевыми
+  static void CopyBits(TWord *dst, int n, const TWord *src, int srcLen, int off);
+  template <class E>
+  void  Eval(const E &e);               // записать в pМем слова выражения e
 public:
-  TBitField(int len);                //                                   (#О1)
-  TBitField(const TBitField &bf);    //                                   (#П1)
-  ~TBitField();                      //                                    (#С)
+  typedef TWord TElem;               // тип эл-та Мем
+
+  // память длинных полей берется из res (по умолчанию - из ресурса
+  // pmr::get_default_resource()); копия и результаты операций используют
+  // ресурс операнда, присваивание сохраняет ресурс левой части
+  TBasicBitField(int len, pmr::memory_resource *res = pmr::get_default_resource()); // (#О1)
+  TBasicBitField(const TBasicBitField &bf);    //                         (#П1)
+  TBasicBitField(const TBasicBitField &bf, pmr::memory_resource *res); // копия в res
+  TBasicBitField(TBasicBitField &&bf);         // перемещение: память bf из кучи передается
+  ~TBasicBitField();                           //                          (#С)
+
+  pmr::memory_resource *GetResource(void) const; // источник памяти поля
 
   // доступ к битам
   int GetLength(void) const;      // получить длину (к-во битов)           (#О)
   void SetBit(const int n);       // установить бит                       (#О4)
   void ClrBit(const int n);       // очистить бит                         (#П2)
   int  GetBit(const int n) const; // получить значение бита               (#Л1)
+  int  Count(void) const;         // к-во установленных битов
+  int  CountRange(const int lo, const int hi) const; // то же в битах lo..hi-1
+
+  // операции над диапазоном битов lo..hi-1: крайние слова - по маскам,
+  // внутренние - заполнением целых слов
+  void SetRange (const int lo, const int hi);       // установить биты
+  void ClrRange (const int lo, const int hi);       // очистить биты
+  void FlipRange(const int lo, const int hi);       // инвертировать биты
+  int  AllInRange(const int lo, const int hi) const; // все ли биты установлены
+  int  AnyInRange(const int lo, const int hi) const; // есть ли установленный бит
+  // копия битов lo..hi-1 - поле длины hi - lo (см. также TBitFieldView)
+  TBasicBitField Extract(const int lo, const int hi) const;
+
+  // поиск установленных битов (-1, если такого бита нет)
+  int FindFirst(void) const;        // первый
+  int FindLast(void) const;         // последний
+  int FindNext(const int n) const;  // первый после n, -1 <= n < BitLen
+  int FindPrev(const int n) const;  // последний до n, 0 <= n <= BitLen
+
+  // перебор номеров установленных битов: for (int n : bf)
+  typedef TBasicBitIterator<TWord> const_iterator;
+  const_iterator begin(void) const;
+  const_iterator end(void) const;
 
   // битовые операции
-  int operator==(const TBitField &bf) const; // сравнение                 (#О5)
-  int operator!=(const TBitField &bf) const; // сравнение
-  TBitField& operator=(const TBitField &bf); // присваивание              (#П3)
-  TBitField  operator|(const TBitField &bf); // операция "или"            (#О6)
-  TBitField  operator&(const TBitField &bf); // операция "и"              (#Л2)
-  TBitField  operator~(void);                // отрицание                  (#С)
-
-  friend istream &operator>>(istream &istr, TBitField &bf);       //      (#О7)
-  friend ostream &operator<<(ostream &ostr, const TBitField &bf); //      (#П4)
+  int operator==(const TBasicBitField &bf) const; // сравнение            (#О5)
+  int operator!=(const TBasicBitField &bf) const; // сравнение
+  TBasicBitField& operator=(const TBasicBitField &bf); // присваивание    (#П3)
+  TBasicBitField& operator=(TBasicBitField &&bf);      // присваивание с перемещением
+
+  TBasicBitField  operator|(const TBasicBitField &bf) const &; // "или"   (#О6)
+  TBasicBitField  operator&(const TBasicBitField &bf) const &; // "и"     (#Л2)
+  TBasicBitField  operator~(void) const &;                     // отрицание (#С)
+
+  // ленивые выражения (tbitexpr.h): Lazy() делает поле листом выражения,
+  // операции "|", "&", "~" над выражением строят дерево, которое вычисляется
+  // за один проход по словам при преобразовании в битовое поле, без
+  // промежуточных полей; выражение ссылается на поля-операнды и годно,
+  // пока они не изменены и не разрушены, поэтому временные поля в него
+  // не принимаются: a.Lazy() | b | ~c.Lazy()
+  typedef TBitLeaf<TWord> TLeaf;
+  TBitExpr<TLeaf> Lazy(void) const &;
+  TBitExpr<TLeaf> Lazy(void) && = delete;
+  template <class E>
+  TBasicBitField(const TBitExpr<E> &e);            // вычисление выражения
+  template <class E>
+  TBasicBitField& operator=(const TBitExpr<E> &e); // вычисление с присваиванием
+
+  // варианты для временных операндов: результат строится в памяти
+  // операнда большей длины, если он временный, без новых выделений
+  TBasicBitField  operator|(const TBasicBitField &bf) &&;
+  TBasicBitField  operator|(TBasicBitField &&bf) const &;
+  TBasicBitField  operator|(TBasicBitField &&bf) &&;
+  TBasicBitField  operator&(const TBasicBitField &bf) &&;
+  TBasicBitField  operator&(TBasicBitField &&bf) const &;
+  TBasicBitField  operator&(TBasicBitField &&bf) &&;
+  TBasicBitField  operator~(void) &&;
+
+  // операции на месте: длина левого операнда сохраняется, недостающие биты
+  // правого операнда считаются нулевыми, лишние - отбрасываются
+  TBasicBitField& operator|=(const TBasicBitField &bf); // "или"
+  TBasicBitField& operator&=(const TBasicBitField &bf); // "и"
+  TBasicBitField& operator^=(const TBasicBitField &bf); // "исключающее или"
+  TBasicBitField& operator-=(const TBasicBitField &bf); // "и-не" (разность)
+
+  // сдвиги на k >= 0 битов, как у целых чисел: сдвиг влево переносит бит n
+  // в бит n + k; выдвинутые за пределы поля биты теряются, освободившиеся -
+  // нулевые; длина сохраняется; сдвиг - один проход по словам
+  TBasicBitField  operator<<(const int k) const;
+  TBasicBitField  operator>>(const int k) const;
+  TBasicBitField& operator<<=(const int k);
+  TBasicBitField& operator>>=(const int k);
+  TBasicBitField& ShiftLeft(const int k);   // то же, что <<=
+  TBasicBitField& ShiftRight(const int k);  // то же, что >>=
+  // циклические сдвиги: бит n переносится в бит (n + k) % BitLen (влево)
+  // или (n - k) mod BitLen (вправо)
+  TBasicBitField& RotateLeft(const int k);
+  TBasicBitField& RotateRight(const int k);
+
+  // "или"/"и" k полей f[0..k-1] за один проход: каждое слово результата
+  // записывается один раз, поля читаются блоками, помещающимися в кэш L1;
+  // длина результата - наибольшая из длин (0 при k == 0)
+  static TBasicBitField UnionAll(const TBasicBitField *const *f, int k);
+  static TBasicBitField IntersectAll(const TBasicBitField *const *f, int k);
+
+  // двоичный формат (см. ниже): заголовок, байты поля, контрольная сумма;
+  // не зависит от типа слов и порядка байтов; Load устанавливает длину
+  // из заголовка, при ошибке формата бросает runtime_error, оставляя поле
+  // без изменений
+  size_t SaveSize(void) const;                // размер записи в байтах
+  void   Save(ostream &ostr) const;            // запись в поток
+  size_t Save(void *buf, size_t size) const;  // запись в буфер, к-во байтов
+  void   Load(istream &istr);                 // чтение из потока
+  size_t Load(const void *buf, size_t size);  // чтение из буфера, к-во байтов
+  // длина поля из записи в buf; заголовок проверяется так же, как в Load,
+  // контрольная сумма - только при check != 0
+  static int SavedLength(const void *buf, size_t size, int check);
+  static const size_t SavedHeaderSize = 24; // байты поля - после заголовка
+
+  template <class> friend class TBitLeaf;
+  friend class TRankSelect;
+  friend class TRoaringSet;
+  friend class TEwahBitField;
+  friend class TConcurrentBitField;
+  friend class TPrimeSieve;
+  friend class TMappedBitField;
+  friend class TBitFieldView;
+  friend istream &operator>>(istream &istr, TSet &s);
+  friend ostream &operator<<(ostream &ostr, const TSet &s);
+
+  template <class TW>
+  friend istream &operator>>(istream &istr, TBasicBitField<TW> &bf);       // (#О7)
+  template <class TW>
+  friend ostream &operator<<(ostream &ostr, const TBasicBitField<TW> &bf); // (#П4)
 };
+
+// однонаправленный итератор по номерам установленных битов поля;
+// стоимость полного перебора - O(к-во установленных битов + MemLen)
+template <class TWord>
+class TBasicBitIterator
+{
+private:
+  const TBasicBitField<TWord> *pField; // поле, по которому ведется перебор
+  int Pos;                             // текущий бит (-1 - конец перебора)
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef int value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const int *pointer;
+  typedef int reference;
+
+  TBasicBitIterator(const TBasicBitField<TWord> *bf, int pos) : pField(bf), Pos(pos) {}
+  int operator*(void) const { return Pos; }
+  TBasicBitIterator& operator++(void) { Pos = pField->FindNext(Pos); return *this; }
+  TBasicBitIterator  operator++(int) { TBasicBitIterator t(*this); ++*this; return t; }
+  bool operator==(const TBasicBitIterator &it) const { return Pos == it.Pos; }
+  bool operator!=(const TBasicBitIterator &it) const { return Pos != it.Pos; }
+};
+
+// определения методов и их явные инстанцирования - в tbitfield.cpp
+typedef TBasicBitField<TELEM> TBitField;                // 32-битные слова
+typedef TBasicBitField<unsigned long long> TBitField64; // 64-битные слова
+#ifdef __SIZEOF_INT128__
+typedef TBasicBitField<unsigned __int128> TBitField128; // 128-битные слова
+#endif
+typedef TBasicBitIterator<TELEM> TBitIterator;
+
 // Структура хранения битового поля
 //   бит.поле - набор битов с номерами от 0 до BitLen
 //   массив pМем рассматривается как последовательность MemLen элементов
+//   типа TWord; при MemLen <= LocalLen pМем указывает на встроенный Local
 //   биты в эл-тах pМем нумеруются справа налево (от младших к старшим)
+// Двоичный формат (все числа - little-endian)
+//   0: "TBIT"; 4: версия (2 байта, 1); 6: 0 (2 байта); 8: BitLen (8 байтов);
+//   16: контрольная сумма (8 байтов); 24: (BitLen + 7) / 8 байтов поля,
+//   бит n - бит n % 8 байта n / 8. Сумма - Флетчера по 64-битным словам
+//   байтов поля (с начальным значением BitLen)
 // О8 Л2 П4 С2
 
+#include "tbitexpr.h"
+
 #endif
@@ -0,0 +1,83 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tbitfieldview.h
+//
+// Представление диапазона битов битового поля без копирования
+//   представление ссылается на память поля (любое смещение диапазона) и
+//   действительно, пока поле существует и не меняет длину
+
+#ifndef __BITFIELDVIEW_H__
+#define __BITFIELDVIEW_H__
+
+#include "tbitfield.h"
+
+class TBitViewIterator;
+
+class TBitFieldView
+{
+private:
+  static const int BitsInElem = sizeof(TELEM) * 8;
+  static const int BlockLen = 256; // к-во слов в блоке операций
+
+  const TBitField *pField; // поле, в памяти которого лежат биты
+  int Lo;                  // номер бита поля, соответствующего биту 0
+  int BitLen;              // длина представления
+
+  // n слов представления, начиная со слова first; слова за пределами
+  // представления - нулевые
+  void Words(int first, int n, TELEM *dst) const;
+  typedef void (*TWordOp)(TELEM *dst, const TELEM *a, const TELEM *b, int n);
+  static TBitField Combine(const TBitFieldView &a, const TBitFieldView &b, TWordOp op);
+public:
+  TBitFieldView(const TBitField &bf);                     // все поле
+  TBitFieldView(const TBitField &bf, int lo, int hi);     // биты lo..hi-1 поля
+  TBitFieldView(const TBitFieldView &v, int lo, int hi);  // биты lo..hi-1 представления
+
+  // доступ к битам - номера отсчитываются от начала представления
+  int GetLength(void) const;      // получить длину (к-во битов)
+  int GetBit(const int n) const;  // получить значение бита
+  int Count(void) const;          // к-во установленных битов
+  int FindFirst(void) const;
+  int FindLast(void) const;
+  int FindNext(const int n) const;
+  int FindPrev(const int n) const;
+  TBitField Extract(void) const;  // копия битов в новое поле
+
+  // перебор номеров установленных битов: for (int n : v)
+  typedef TBitViewIterator const_iterator;
+  TBitViewIterator begin(void) const;
+  TBitViewIterator end(void) const;
+
+  // битовые операции: операнды - представления или поля (преобразуются в
+  // представления); длина результата - наибольшая из длин, недостающие
+  // биты считаются нулевыми, как у TBitField
+  int operator==(const TBitFieldView &v) const;
+  int operator!=(const TBitFieldView &v) const;
+  friend TBitField operator|(const TBitFieldView &a, const TBitFieldView &b); // "или"
+  friend TBitField operator&(const TBitFieldView &a, const TBitFieldView &b); // "и"
+  friend TBitField operator^(const TBitFieldView &a, const TBitFieldView &b); // "искл. или"
+  TBitField operator~(void) const;                                            // отрицание
+};
+
+// однонаправленный итератор по номерам установленных битов представления
+class TBitViewIterator
+{
+private:
+  const TBitFieldView *pView; // представление, по которому ведется перебор
+  int Pos;                    // текущий бит (-1 - конец перебора)
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef int value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const int *pointer;
+  typedef int reference;
+
+  TBitViewIterator(const TBitFieldView *v, int pos) : pView(v), Pos(pos) {}
+  int operator*(void) const { return Pos; }
+  TBitViewIterator& operator++(void) { Pos = pView->FindNext(Pos); return *this; }
+  TBitViewIterator  operator++(int) { TBitViewIterator t(*this); ++*this; return t; }
+  bool operator==(const TBitViewIterator &it) const { return Pos == it.Pos; }
+  bool operator!=(const TBitViewIterator &it) const { return Pos != it.Pos; }
+};
+
+#endif
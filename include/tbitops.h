@@ -0,0 +1,199 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tbitops.h
+//
+// Ядра поразрядных операций над массивами слов
+//   векторные реализации (SSE2/AVX2/AVX-512) выбираются во время выполнения
+//   по возможностям процессора, при их отсутствии используется скалярный цикл
+//   массивы не короче порога делятся на части, обрабатываемые пулом потоков
+
+#ifndef __BITOPS_H__
+#define __BITOPS_H__
+
+#include <cstddef>
+
+enum TBitOpsIsa // набор инструкций, используемый ядрами
+{
+  BITOPS_SCALAR,
+  BITOPS_SSE2,
+  BITOPS_AVX2,
+  BITOPS_AVX512
+};
+
+TBitOpsIsa BitOpsGetIsa(void);             // текущий набор инструкций
+int  BitOpsSetIsa(TBitOpsIsa isa);         // выбрать набор (0 - не поддерживается)
+const char *BitOpsIsaName(TBitOpsIsa isa); // название набора инструкций
+
+// параллельное выполнение: массив от BitOpsGetParallelBytes() байтов
+// делится на BitOpsGetThreads() частей по границам строк кэша; часть k
+// всегда обрабатывается одним и тем же потоком пула (потоки не привязаны
+// к ядрам); настройки можно менять во время работы других потоков
+int    BitOpsGetThreads(void);
+void   BitOpsSetThreads(int n);             // n <= 0 - по к-ву ядер
+size_t BitOpsGetParallelBytes(void);
+void   BitOpsSetParallelBytes(size_t bytes); // порог параллельного выполнения
+
+// выполнить task над частями [lo, hi) диапазона [0, bytes): параллельно,
+// если диапазон не короче порога и пул свободен, иначе - одним вызовом
+typedef void (*TBitTask)(size_t lo, size_t hi, void *ctx);
+void BitParallelFor(size_t bytes, TBitTask task, void *ctx);
+
+// ядра работают с памятью побайтно и не зависят от типа слов;
+// dst[i] = a[i] op b[i], i = 0..bytes-1; dst может совпадать с a или b
+void BitOrBytes (void *dst, const void *a, const void *b, size_t bytes);
+void BitAndBytes(void *dst, const void *a, const void *b, size_t bytes);
+void BitXorBytes(void *dst, const void *a, const void *b, size_t bytes);
+void BitAndNotBytes(void *dst, const void *a, const void *b, size_t bytes); // a & ~b
+void BitNotBytes(void *dst, const void *a, size_t bytes);
+
+long long BitCountBytes(const void *a, size_t bytes); // к-во единичных битов
+
+// заполнение, копирование и сравнение (аналоги memset, memcpy, memcmp == 0)
+void BitZeroBytes(void *dst, size_t bytes);
+void BitCopyBytes(void *dst, const void *a, size_t bytes);
+int  BitEqualBytes(const void *a, const void *b, size_t bytes);
+
+// типизированные обертки: n - к-во слов типа TWord
+template <class TWord>
+inline void BitOr(TWord *dst, const TWord *a, const TWord *b, int n)
+{
+  BitOrBytes(dst, a, b, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitAnd(TWord *dst, const TWord *a, const TWord *b, int n)
+{
+  BitAndBytes(dst, a, b, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitXor(TWord *dst, const TWord *a, const TWord *b, int n)
+{
+  BitXorBytes(dst, a, b, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitAndNot(TWord *dst, const TWord *a, const TWord *b, int n)
+{
+  BitAndNotBytes(dst, a, b, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitNot(TWord *dst, const TWord *a, int n)
+{
+  BitNotBytes(dst, a, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline int BitCount(const TWord *a, int n) // к-во единичных битов в a[0..n-1]
+{
+  return (int)BitCountBytes(a, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitZero(TWord *dst, int n)
+{
+  BitZeroBytes(dst, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline void BitCopy(TWord *dst, const TWord *a, int n)
+{
+  BitCopyBytes(dst, a, size_t(n) * sizeof(TWord));
+}
+
+template <class TWord>
+inline int BitEqual(const TWord *a, const TWord *b, int n)
+{
+  return BitEqualBytes(a, b, size_t(n) * sizeof(TWord));
+}
+
+// к-во единичных битов в одном слове; constexpr - для полей, вычисляемых
+// при компиляции (tfixedbitfield.h)
+constexpr int BitPopcount(unsigned int x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(x);
+#else
+  int n = 0;
+  for (; x != 0; x &= x - 1)
+    n++;
+  return n;
+#endif
+}
+
+constexpr int BitPopcount(unsigned long long x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  return BitPopcount((unsigned int)x) + BitPopcount((unsigned int)(x >> 32));
+#endif
+}
+
+// номер младшего/старшего единичного бита, x != 0
+inline int BitLowest(unsigned int x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#else
+  int n = 0;
+  for (; (x & 1) == 0; x >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+inline int BitLowest(unsigned long long x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  return ((unsigned int)x != 0) ? BitLowest((unsigned int)x) :
+                                  32 + BitLowest((unsigned int)(x >> 32));
+#endif
+}
+
+inline int BitHighest(unsigned int x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return int(sizeof(x) * 8) - 1 - __builtin_clz(x);
+#else
+  int n = -1;
+  for (; x != 0; x >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+inline int BitHighest(unsigned long long x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return int(sizeof(x) * 8) - 1 - __builtin_clzll(x);
+#else
+  return ((unsigned int)(x >> 32) != 0) ? 32 + BitHighest((unsigned int)(x >> 32)) :
+                                          BitHighest((unsigned int)x);
+#endif
+}
+
+#ifdef __SIZEOF_INT128__
+// 128-битные слова обрабатываются по половинам
+constexpr int BitPopcount(unsigned __int128 x)
+{
+  return BitPopcount((unsigned long long)x) + BitPopcount((unsigned long long)(x >> 64));
+}
+
+inline int BitLowest(unsigned __int128 x)
+{
+  return ((unsigned long long)x != 0) ? BitLowest((unsigned long long)x) :
+                                        64 + BitLowest((unsigned long long)(x >> 64));
+}
+
+inline int BitHighest(unsigned __int128 x)
+{
+  return ((unsigned long long)(x >> 64) != 0) ? 64 + BitHighest((unsigned long long)(x >> 64)) :
+                                                BitHighest((unsigned long long)x);
+}
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tconcurrentbitfield.h
+//
+// Битовое поле с атомарным доступом к битам из нескольких потоков
+
+#ifndef __CONCURRENTBITFIELD_H__
+#define __CONCURRENTBITFIELD_H__
+
+#include "tbitfield.h"
+
+#include <atomic>
+#include <vector>
+
+class TConcurrentBitField
+{
+private:
+  static const int BitsInElem = sizeof(TELEM) * 8;
+
+  int BitLen;                    // длина битового поля
+  vector<atomic<TELEM> > Mem;    // слова поля; раскладка - как у TBitField
+
+  int   GetMemIndex(const int n) const; // индекс в Mem для бита n
+  TELEM GetMemMask (const int n) const; // битовая маска для бита n
+  void  CheckIndex (const int n) const; // исключение при n вне поля
+public:
+  TConcurrentBitField(int len);              // нулевое поле длины len
+  TConcurrentBitField(const TBitField &bf);  // копия битового поля
+  TConcurrentBitField(const TConcurrentBitField &) = delete;
+  TConcurrentBitField& operator=(const TConcurrentBitField &) = delete;
+
+  int GetLength(void) const;      // получить длину (к-во битов)
+
+  // изменение бита - одна атомарная операция над словом (fetch_or/fetch_and),
+  // без блокировок; изменения одного бита упорядочены (acquire-release)
+  void SetBit(const int n);       // установить бит
+  void ClrBit(const int n);       // очистить бит
+  int  TestAndSet(const int n);   // установить бит, вернуть прежнее значение
+  int  TestAndClear(const int n); // очистить бит, вернуть прежнее значение
+  int  GetBit(const int n) const; // получить значение бита
+
+  // слова читаются по одному (relaxed): при одновременных изменениях
+  // результат может не совпадать ни с одним состоянием поля целиком,
+  // но каждое слово - одно из его состояний
+  int Count(void) const;          // к-во установленных битов
+  TBitField Snapshot(void) const; // копия в обычное битовое поле
+};
+
+#endif
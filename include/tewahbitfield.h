@@ -0,0 +1,46 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tewahbitfield.h
+//
+// Битовое поле, сжатое кодированием серий (EWAH)
+
+#ifndef __EWAHBITFIELD_H__
+#define __EWAHBITFIELD_H__
+
+#include "tbitfield.h"
+
+#include <vector>
+
+typedef unsigned long long TEWORD; // слово сжатого представления
+
+class TEwahBitField
+{
+private:
+  int BitLen;             // длина битового поля
+  vector<TEWORD> Buffer;  // маркеры и литеральные слова
+public:
+  TEwahBitField(int len);               // нулевое поле длины len
+  TEwahBitField(const TBitField &bf);   // сжатие битового поля
+  operator TBitField() const;           // распаковка
+
+  int GetLength(void) const;      // получить длину (к-во битов)
+  int GetBit(const int n) const;  // получить значение бита, O(размера сжатых данных)
+  int Count(void) const;          // к-во установленных битов
+  int SizeInWords(void) const;    // размер сжатого представления в словах
+
+  // операции выполняются потоково над сжатыми данными, без распаковки,
+  // за O(суммарного размера сжатых операндов); длина результата - большая
+  // из длин, недостающие биты более короткого операнда считаются нулевыми
+  int operator==(const TEwahBitField &bf) const;
+  int operator!=(const TEwahBitField &bf) const;
+  TEwahBitField operator|(const TEwahBitField &bf) const; // операция "или"
+  TEwahBitField operator&(const TEwahBitField &bf) const; // операция "и"
+  TEwahBitField operator~(void) const;                    // отрицание
+};
+// Структура хранения
+//   поле - последовательность 64-битных слов (последнее дополнено нулями);
+//   Buffer состоит из групп: маркер, за которым следуют литеральные слова.
+//   Маркер: бит 0 - значение битов серии, биты 1..32 - к-во "чистых" слов
+//   серии (все биты равны), биты 33..63 - к-во следующих за ним литералов.
+
+#endif
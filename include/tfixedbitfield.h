@@ -0,0 +1,155 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tfixedbitfield.h
+//
+// Битовое поле фиксированной длины, известной при компиляции
+
+#ifndef __FIXEDBITFIELD_H__
+#define __FIXEDBITFIELD_H__
+
+#include "tbitfield.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+
+// память размещается внутри объекта, без выделений из кучи; доступ к битам
+// и поразрядные операции - constexpr и могут вычисляться при компиляции
+template <int N>
+class TFixedBitField
+{
+  static_assert(N >= 0, "negative bitfield length");
+private:
+  typedef unsigned long long TWord;
+  static constexpr int BitsInElem = sizeof(TWord) * 8;  // к-во битов в эл-те Мем
+  static constexpr int MemLen = (N > 0) ? (N + BitsInElem - 1) / BitsInElem : 1;
+
+  TWord Mem[MemLen]; // память для представления битового поля
+
+  // методы реализации
+  static constexpr int   GetMemIndex(const int n) { return n / BitsInElem; }
+  static constexpr TWord GetMemMask (const int n) { return TWord(1) << (n % BitsInElem); }
+  static constexpr TWord TailMask(void) // допустимые биты последнего эл-та Мем
+  {
+    return (N == 0) ? 0 : (N % BitsInElem) ? GetMemMask(N) - 1 : ~TWord(0);
+  }
+  static constexpr int CheckIndex(const int n)
+  {
+    return ((n < 0) || (n >= N)) ? throw out_of_range("bit index out of range") : n;
+  }
+public:
+  constexpr TFixedBitField() : Mem{} {}
+  TFixedBitField(const TBitField &bf); // преобразование, биты с номерами >= N отбрасываются
+  operator TBitField() const;          // преобразование к битовому полю длины N
+
+  // доступ к битам
+  static constexpr int GetLength(void) { return N; } // получить длину (к-во битов)
+  constexpr void SetBit(const int n)                  // установить бит
+  {
+    Mem[GetMemIndex(CheckIndex(n))] |= GetMemMask(n);
+  }
+  constexpr void ClrBit(const int n)                  // очистить бит
+  {
+    Mem[GetMemIndex(CheckIndex(n))] &= ~GetMemMask(n);
+  }
+  constexpr int GetBit(const int n) const             // получить значение бита
+  {
+    return (Mem[GetMemIndex(CheckIndex(n))] & GetMemMask(n)) != 0;
+  }
+  constexpr int Count(void) const                     // к-во установленных битов
+  {
+    int res = 0;
+    for (int i = 0; i < MemLen; i++)
+      res += BitPopcount(Mem[i]);
+    return res;
+  }
+
+  // битовые операции
+  constexpr int operator==(const TFixedBitField &bf) const // сравнение
+  {
+    for (int i = 0; i < MemLen; i++)
+      if (Mem[i] != bf.Mem[i])
+        return 0;
+    return 1;
+  }
+  constexpr int operator!=(const TFixedBitField &bf) const { return !(*this == bf); }
+  constexpr TFixedBitField operator|(const TFixedBitField &bf) const // операция "или"
+  {
+    TFixedBitField res;
+    for (int i = 0; i < MemLen; i++)
+      res.Mem[i] = Mem[i] | bf.Mem[i];
+    return res;
+  }
+  constexpr TFixedBitField operator&(const TFixedBitField &bf) const // операция "и"
+  {
+    TFixedBitField res;
+    for (int i = 0; i < MemLen; i++)
+      res.Mem[i] = Mem[i] & bf.Mem[i];
+    return res;
+  }
+  constexpr TFixedBitField operator~(void) const                     // отрицание
+  {
+    TFixedBitField res;
+    for (int i = 0; i < MemLen; i++)
+      res.Mem[i] = ~Mem[i];
+    res.Mem[MemLen - 1] &= TailMask(); // биты за пределами N остаются нулевыми
+    return res;
+  }
+  constexpr TFixedBitField& operator|=(const TFixedBitField &bf) { return *this = *this | bf; }
+  constexpr TFixedBitField& operator&=(const TFixedBitField &bf) { return *this = *this & bf; }
+  constexpr TFixedBitField& operator-=(const TFixedBitField &bf)     // "и-не" (разность)
+  {
+    for (int i = 0; i < MemLen; i++)
+      Mem[i] &= ~bf.Mem[i];
+    return *this;
+  }
+};
+// Структура хранения - как у TBitField, но с 64-битными эл-тами Мем
+// во встроенном массиве; неиспользуемые биты последнего эл-та всегда нулевые
+
+template <int N>
+constexpr int TFixedBitField<N>::BitsInElem;
+
+template <int N>
+constexpr int TFixedBitField<N>::MemLen;
+
+template <int N>
+TFixedBitField<N>::TFixedBitField(const TBitField &bf) : Mem{}
+{
+  for (int n : bf)
+  {
+    if (n >= N)
+      break;
+    SetBit(n);
+  }
+}
+
+template <int N>
+TFixedBitField<N>::operator TBitField() const
+{
+  TBitField res(N);
+  for (int i = 0; i < MemLen; i++)
+    for (TWord w = Mem[i]; w != 0; w &= w - 1)
+      res.SetBit(i * BitsInElem + BitLowest(w));
+  return res;
+}
+
+// ввод/вывод в формате TBitField
+
+template <int N>
+istream &operator>>(istream &istr, TFixedBitField<N> &bf)
+{
+  TBitField t(N);
+  istr >> t;
+  bf = TFixedBitField<N>(t);
+  return istr;
+}
+
+template <int N>
+ostream &operator<<(ostream &ostr, const TFixedBitField<N> &bf)
+{
+  for (int i = 0; i < N; i++)
+    ostr << (bf.GetBit(i) ? '1' : '0');
+  return ostr;
+}
+
+#endif
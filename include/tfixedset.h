@@ -0,0 +1,87 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tfixedset.h
+//
+// Множество с мощностью универса, известной при компиляции
+
+#ifndef __FIXEDSET_H__
+#define __FIXEDSET_H__
+
+#include "tfixedbitfield.h"
+#include "tset.h"
+
+template <int N>
+class TFixedSet
+{
+private:
+  TFixedBitField<N> BitField; // битовое поле для хранения характеристического вектора
+public:
+  constexpr TFixedSet() : BitField() {}
+  constexpr TFixedSet(const TFixedBitField<N> &bf) : BitField(bf) {}
+  TFixedSet(const TSet &s); // преобразование, элементы >= N отбрасываются
+  operator TSet() const;    // преобразование к множеству мощности N
+  constexpr operator TFixedBitField<N>() const { return BitField; }
+  // доступ к битам
+  static constexpr int GetMaxPower(void) { return N; } // максимальная мощность множества
+  int Cardinality(void) const { return BitField.Count(); }   // мощность множества
+  constexpr void InsElem(const int Elem) { BitField.SetBit(Elem); } // включить элемент
+  constexpr void DelElem(const int Elem) { BitField.ClrBit(Elem); } // удалить элемент
+  constexpr int IsMember(const int Elem) const { return BitField.GetBit(Elem); }
+  // теоретико-множественные операции
+  constexpr int operator== (const TFixedSet &s) const { return BitField == s.BitField; }
+  constexpr int operator!= (const TFixedSet &s) const { return BitField != s.BitField; }
+  constexpr TFixedSet operator+ (const int Elem) const // объединение с элементом
+  {
+    TFixedSet res(*this);
+    res.InsElem(Elem);
+    return res;
+  }
+  constexpr TFixedSet operator- (const int Elem) const // разность с элементом
+  {
+    TFixedSet res(*this);
+    res.DelElem(Elem);
+    return res;
+  }
+  constexpr TFixedSet operator+ (const TFixedSet &s) const { return BitField | s.BitField; }
+  constexpr TFixedSet operator* (const TFixedSet &s) const { return BitField & s.BitField; }
+  constexpr TFixedSet operator~ (void) const { return ~BitField; }
+  constexpr TFixedSet& operator+=(const TFixedSet &s) { BitField |= s.BitField; return *this; }
+  constexpr TFixedSet& operator*=(const TFixedSet &s) { BitField &= s.BitField; return *this; }
+  constexpr TFixedSet& operator-=(const TFixedSet &s) { BitField -= s.BitField; return *this; }
+};
+
+template <int N>
+TFixedSet<N>::TFixedSet(const TSet &s)
+{
+  for (int e : s)
+  {
+    if (e >= N)
+      break;
+    InsElem(e);
+  }
+}
+
+template <int N>
+TFixedSet<N>::operator TSet() const
+{
+  return TSet(TBitField(BitField));
+}
+
+// ввод/вывод в формате TSet
+
+template <int N>
+istream &operator>>(istream &istr, TFixedSet<N> &s)
+{
+  TSet t(N);
+  istr >> t;
+  s = TFixedSet<N>(t);
+  return istr;
+}
+
+template <int N>
+ostream &operator<<(ostream &ostr, const TFixedSet<N> &s)
+{
+  return ostr << TSet(s);
+}
+
+#endif
@@ -0,0 +1,68 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tmappedbitfield.h
+//
+// Битовое поле, отображенное в память из файла двоичного формата
+//   файл (см. TBitField::Save) отображается через mmap без чтения и
+//   копирования: страницы подгружаются при обращении и разделяются
+//   процессами через кэш страниц
+
+#ifndef __MAPPEDBITFIELD_H__
+#define __MAPPEDBITFIELD_H__
+
+#include "tbitfield.h"
+
+class TMappedBitField
+{
+public:
+  enum TMode { ReadOnly, CopyOnWrite };  // режим отображения
+  enum TAccess { Normal, Sequential, Random, WillNeed }; // порядок доступа
+private:
+  TBitField Field; // поле, память которого - отображение файла
+  void *pMap;      // начало отображения
+  size_t MapSize;  // размер отображения
+  TMode Mode;
+
+  void Unmap(void);
+public:
+  // отображение файла name; файл должен содержать ровно одну запись,
+  // заголовок проверяется всегда, контрольная сумма - при verify != 0
+  // (для этого читается весь файл)
+  TMappedBitField(const char *name, TMode mode = ReadOnly, int verify = 0);
+  TMappedBitField(const TMappedBitField &) = delete;
+  TMappedBitField& operator=(const TMappedBitField &) = delete;
+  ~TMappedBitField();
+
+  // поле для чтения: запросы, перебор, операции над полями (|, &, ~,
+  // UnionAll, Lazy) и копирование в обычное поле работают прямо
+  // с отображенной памятью, например GetField() | bf - операции TBitField
+  // не применяются к самому TMappedBitField; ссылка действительна, пока
+  // существует отображение
+  const TBitField &GetField(void) const;
+  operator const TBitField &(void) const;
+  TMode GetMode(void) const;
+
+  // доступ к битам
+  int GetLength(void) const;      // получить длину (к-во битов)
+  int GetBit(const int n) const;  // получить значение бита
+  int Count(void) const;          // к-во установленных битов
+  int CountRange(const int lo, const int hi) const; // то же в битах lo..hi-1
+  int FindFirst(void) const;
+  int FindLast(void) const;
+  int FindNext(const int n) const;
+  int FindPrev(const int n) const;
+  TBitIterator begin(void) const;
+  TBitIterator end(void) const;
+
+  // изменение битов - только в режиме CopyOnWrite (иначе logic_error):
+  // измененные страницы копируются, файл не меняется
+  void SetBit(const int n);
+  void ClrBit(const int n);
+
+  // подсказка ядру о порядке доступа (madvise): Sequential - перед
+  // операциями над всем полем, Random - для одиночных запросов,
+  // WillNeed - упреждающее чтение всего файла
+  void Advise(TAccess a) const;
+};
+
+#endif
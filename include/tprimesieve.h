@@ -0,0 +1,91 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tprimesieve.h
+//
+// Сегментированное решето Эратосфена на битовых полях
+
+#ifndef __PRIMESIEVE_H__
+#define __PRIMESIEVE_H__
+
+#include "tbitfield.h"
+
+#include <vector>
+
+class TPrimeIterator;
+
+// простые числа от Low до Limit в порядке возрастания; числа просеиваются
+// сегментами, помещающимися в кэш L1, поэтому память - O(sqrt(Limit))
+// независимо от длины диапазона
+class TPrimeSieve
+{
+private:
+  static const int SegmentBits = 32768 * 8; // нечетных чисел в сегменте (32 КиБ)
+  static const int WheelWords = 105;        // период шаблона 3*5*7 в словах
+
+  long long Low, Limit;    // границы диапазона
+  vector<int> Primes;      // нечетные простые от 11 до sqrt(Limit)
+  vector<long long> Next;  // номер следующего вычеркиваемого кратного Primes[k]
+  TBitField Wheel;         // шаблон: нечетные числа, не кратные 3, 5, 7
+  TBitField Segment;       // бит i - число SegStart + 2 * i
+  long long SegIndex;      // номер первого бита сегмента среди нечетных чисел
+  int SegLen;              // к-во используемых битов сегмента (0 - нет сегмента)
+  int Pos;                 // последний выданный бит сегмента
+  int TwoDone;             // число 2 уже выдано или не входит в диапазон
+
+  int SieveNext(void);     // просеять следующий сегмент (0, если чисел больше нет)
+  // перейти к диапазону low..limit, не большему исходного (простые до
+  // sqrt(limit) уже найдены)
+  void Restart(long long low, long long limit);
+public:
+  static const long long MaxLimit = 1000000000000000000ll; // 10^18
+
+  explicit TPrimeSieve(long long limit);  // простые от 2 до limit
+  TPrimeSieve(long long low, long long limit); // простые от low до limit
+
+  long long GetLow(void) const;
+  long long GetLimit(void) const;
+  long long NextPrime(void); // следующее простое (-1, если простых до Limit больше нет)
+
+  // однократный перебор: for (long long p : TPrimeSieve(n))
+  TPrimeIterator begin(void);
+  TPrimeIterator end(void);
+
+  static long long CountPrimes(long long n); // к-во простых чисел, не больших n
+  static long long CountPrimes(long long low, long long n); // то же от low до n
+
+  // параллельный режим: диапазон low..n делится на части, которые потоки
+  // (threads <= 0 - по к-ву ядер) разбирают по очереди и просеивают
+  // независимо, каждый своим сегментом; простые до sqrt(n) находятся один раз
+  static long long CountPrimes(long long low, long long n, int threads);
+  // visit(p, ctx) вызывается в вызывающем потоке для простых по возрастанию;
+  // готовых, но еще не выданных частей - не более 2 * threads
+  typedef void (*TPrimeVisitor)(long long p, void *ctx);
+  static void VisitPrimes(long long low, long long n, int threads, TPrimeVisitor visit, void *ctx);
+};
+
+// однопроходный итератор по простым числам решета
+class TPrimeIterator
+{
+private:
+  TPrimeSieve *pSieve;
+  long long Value; // текущее простое (-1 - конец перебора)
+public:
+  typedef input_iterator_tag iterator_category;
+  typedef long long value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const long long *pointer;
+  typedef long long reference;
+
+  TPrimeIterator(TPrimeSieve *s, long long v) : pSieve(s), Value(v) {}
+  long long operator*(void) const { return Value; }
+  TPrimeIterator& operator++(void) { Value = pSieve->NextPrime(); return *this; }
+  bool operator==(const TPrimeIterator &it) const { return Value == it.Value; }
+  bool operator!=(const TPrimeIterator &it) const { return Value != it.Value; }
+};
+// Структура решета
+//   хранятся только нечетные числа: бит с номером i среди нечетных - число
+//   2 * i + 1. Сегмент заполняется копированием слов шаблона Wheel (кратные
+//   3, 5, 7 уже вычеркнуты), затем вычеркиваются кратные простых от 11
+//   до sqrt(конца сегмента), начиная с p * p, с шагом 2p.
+
+#endif
@@ -0,0 +1,58 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// trankselect.h
+//
+// Индекс ранга и выбора над битовым полем
+
+#ifndef __RANKSELECT_H__
+#define __RANKSELECT_H__
+
+#include "tbitfield.h"
+
+#include <vector>
+
+class TRankSelect
+{
+private:
+  TBitField *pField; // индексируемое битовое поле
+  int BitLen;        // длина поля на момент построения индекса
+  const TELEM *pMem; // память поля на момент построения индекса
+  unsigned Changes;  // счетчик изменений поля на момент построения индекса
+  int Total;         // к-во установленных битов поля
+  // по одному 64-битному слову на базовый блок из 2048 битов:
+  //   биты 0..31  - к-во единиц до начала базового блока
+  //   биты 32..61 - к-во единиц в первых трех блоках по 512 битов (по 10 битов)
+  // последнее слово - ограничитель (к-во единиц во всем поле)
+  vector<unsigned long long> Index;
+  // номер базового блока, содержащего каждую SelectStep-ю единицу
+  mutable vector<int> Samples;
+  mutable int SamplesValid; // выборки актуальны (сбрасывается при SetBit/ClrBit)
+
+  void BuildSamples(void) const;
+  void CheckFresh(void) const; // исключение, если поле изменено в обход индекса
+  int  BlockCount(int b, int sub) const; // к-во единиц в блоке sub базового блока b
+public:
+  TRankSelect(TBitField &bf); // индекс строится сразу; поле должно жить дольше индекса
+
+  // запросы к индексу поля, измененного в обход индекса (в т.ч. присваиванием
+  // или перемещением), бросают logic_error до вызова Build
+  void Build(void);           // перестроить индекс после изменения поля в обход индекса
+  int  IsFresh(void) const;   // соответствует ли индекс полю
+  int  GetCount(void) const;  // к-во установленных битов
+  int  IndexSize(void) const; // объем индекса в байтах
+
+  int Rank(const int n) const;  // к-во установленных битов с номерами < n, 0 <= n <= BitLen
+  int Select(const int k) const; // номер k-го (с 0) установленного бита, 0 <= k < GetCount()
+
+  // изменение поля с обновлением индекса за O(BitLen / 2048)
+  void SetBit(const int n);
+  void ClrBit(const int n);
+};
+// Схема индекса соответствует раскладке poppy (Zhou, Andersen, Kaminsky):
+// 64 бита на 2048 битов поля (3.1%) и 32 бита на каждые 8192 единицы для
+// выбора (не более 0.4%). Rank - O(1): слово индекса и до 15 эл-тов Мем;
+// Select - двоичный поиск между соседними выборками и O(1) внутри блока.
+// Изменение поля мимо SetBit/ClrBit индекса обнаруживается по счетчику
+// изменений поля и требует вызова Build().
+
+#endif
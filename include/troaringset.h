@@ -0,0 +1,77 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// troaringset.h
+//
+// Множество - сжатое представление в стиле Roaring
+
+#ifndef __ROARINGSET_H__
+#define __ROARINGSET_H__
+
+#include "tset.h"
+
+#include <vector>
+
+enum TRoaringType // вид контейнера
+{
+  ROARING_ARRAY,  // отсортированный массив младших 16 битов элементов
+  ROARING_BITMAP, // битовая шкала из 2^16 битов
+  ROARING_RUN     // отсортированные серии (начало, длина - 1)
+};
+
+// контейнер хранит элементы с одинаковыми старшими 16 битами
+struct TRoaringContainer
+{
+  unsigned short Key;                // старшие 16 битов элементов
+  TRoaringType Type;                 // вид контейнера
+  int Card;                          // к-во элементов в контейнере
+  vector<unsigned short> Data;       // ROARING_ARRAY и ROARING_RUN
+  vector<unsigned long long> Bits;   // ROARING_BITMAP, 1024 слова
+};
+
+class TRoaringSet
+{
+private:
+  int MaxPower;                    // максимальная мощность множества
+  vector<TRoaringContainer> Cont;  // непустые контейнеры по возрастанию Key
+
+  int Find(unsigned short key) const; // индекс контейнера с ключом key или -1
+public:
+  TRoaringSet(int mp);
+  TRoaringSet(const TSet &s);  // конструктор преобразования типа
+  operator TSet() const;       // преобразование типа к множеству
+  // доступ к элементам
+  int GetMaxPower(void) const;        // максимальная мощность множества
+  int Cardinality(void) const;        // мощность (к-во элементов) множества
+  void InsElem(const int Elem);       // включить элемент в множество
+  void DelElem(const int Elem);       // удалить элемент из множества
+  int IsMember(const int Elem) const; // проверить наличие элемента в множестве
+  // представление
+  void RunOptimize(void);        // выбрать для каждого контейнера самый компактный вид
+  int  ContainerCount(void) const; // к-во контейнеров
+  int  MemoryUsage(void) const;  // объем данных контейнеров в байтах
+  // теоретико-множественные операции
+  int operator== (const TRoaringSet &s) const; // сравнение
+  int operator!= (const TRoaringSet &s) const; // сравнение
+  TRoaringSet operator+ (const int Elem) const; // объединение с элементом
+  TRoaringSet operator- (const int Elem) const; // разность с элементом
+  TRoaringSet operator+ (const TRoaringSet &s) const; // объединение
+  TRoaringSet operator* (const TRoaringSet &s) const; // пересечение
+  TRoaringSet operator~ (void) const;                 // дополнение
+  TRoaringSet& operator+=(const TRoaringSet &s);      // объединение на месте
+  TRoaringSet& operator*=(const TRoaringSet &s);      // пересечение на месте
+  // объединение/пересечение k множеств: контейнеры с одинаковым ключом
+  // выбираются из всех множеств сразу (для объединения - через кучу по
+  // ключам), поэтому каждый фрагмент результата строится один раз
+  static TRoaringSet UnionAll(const TRoaringSet *const *sets, int k);
+  static TRoaringSet IntersectAll(const TRoaringSet *const *sets, int k);
+
+  friend istream &operator>>(istream &istr, TRoaringSet &s);
+  friend ostream &operator<<(ostream &ostr, const TRoaringSet &s);
+};
+// Универс [0, MaxPower) делится на фрагменты по 2^16 элементов. Для непустого
+// фрагмента хранится контейнер: массив (до 4096 элементов), битовая шкала
+// (8 КБ) или серии; вид меняется автоматически при вставке, удалении и
+// операциях. Пустые фрагменты не хранятся и пропускаются операциями, поэтому
+// память пропорциональна содержимому, а не MaxPower.
+
+#endif
@@ -10,34 +10,94 @@
 
 #include "tbitfield.h"
 
+template <class E> class TSetExpr; // ленивое выражение над множествами (tsetexpr.h)
+
 class TSet
 {
 private:
   int MaxPower;       // максимальная мощность множества
   TBitField BitField; // битовое поле для хранения характеристического вектора
 public:
-  TSet(int mp);
+  // память поля берется из res; результаты операций используют ресурс операнда
+  TSet(int mp, pmr::memory_resource *res = pmr::get_default_resource());
   TSet(const TSet &s);       // конструктор копирования
+  TSet(TSet &&s);            // конструктор перемещения
   TSet(const TBitField &bf); // конструктор преобразования типа
-  operator TBitField();      // преобразование типа к битовому полю
+  TSet(TBitField &&bf);      // преобразование с перемещением поля
+  operator TBitField() const &; // преобразование типа к битовому полю
+  operator TBitField() &&;
   // доступ к битам
   int GetMaxPower(void) const;     // максимальная мощность множества
+  pmr::memory_resource *GetResource(void) const; // источник памяти множества
+  int Cardinality(void) const;     // мощность (к-во элементов) множества
   void InsElem(const int Elem);       // включить элемент в множество
   void DelElem(const int Elem);       // удалить элемент из множества
   int IsMember(const int Elem) const; // проверить наличие элемента в множестве
+  void InsRange(const int lo, const int hi); // включить элементы lo..hi-1
+  void DelRange(const int lo, const int hi); // удалить элементы lo..hi-1
+  // поиск элементов (-1, если такого элемента нет)
+  int FindFirst(void) const;          // наименьший элемент
+  int FindLast(void) const;           // наибольший элемент
+  int FindNext(const int Elem) const; // наименьший элемент, больший Elem
+  int FindPrev(const int Elem) const; // наибольший элемент, меньший Elem
+  // перебор элементов по возрастанию: for (int e : s)
+  typedef TBitIterator const_iterator;
+  TBitIterator begin(void) const;
+  TBitIterator end(void) const;
   // теоретико-множественные операции
   int operator== (const TSet &s) const; // сравнение
   int operator!= (const TSet &s) const; // сравнение
   TSet& operator=(const TSet &s);  // присваивание
-  TSet operator+ (const int Elem); // объединение с элементом
+  TSet& operator=(TSet &&s);       // присваивание с перемещением
+  TSet operator+ (const int Elem) const &; // объединение с элементом
                                    // элемент должен быть из того же универса
-  TSet operator- (const int Elem); // разность с элементом
+  TSet operator- (const int Elem) const &; // разность с элементом
                                    // элемент должен быть из того же универса
-  TSet operator+ (const TSet &s);  // объединение
-  TSet operator* (const TSet &s);  // пересечение
-  TSet operator~ (void);           // дополнение
+  TSet operator+ (const TSet &s) const &;  // объединение
+  TSet operator* (const TSet &s) const &;  // пересечение
+  TSet operator~ (void) const &;           // дополнение
+  // ленивые выражения "+", "*", "~", вычисляемые за один проход при
+  // преобразовании в TSet: a.Lazy() + b * ~c.Lazy() (см. tbitfield.h)
+  typedef TBitLeaf<TELEM> TLeaf;
+  TSetExpr<TLeaf> Lazy(void) const &;
+  TSetExpr<TLeaf> Lazy(void) && = delete;
+  template <class E>
+  TSet(const TSetExpr<E> &e);            // вычисление выражения
+  template <class E>
+  TSet& operator=(const TSetExpr<E> &e); // вычисление с присваиванием
+  // варианты для временных операндов (переиспользуют их память)
+  TSet operator+ (const int Elem) &&;
+  TSet operator- (const int Elem) &&;
+  TSet operator+ (const TSet &s) &&;
+  TSet operator+ (TSet &&s) const &;
+  TSet operator+ (TSet &&s) &&;
+  TSet operator* (const TSet &s) &&;
+  TSet operator* (TSet &&s) const &;
+  TSet operator* (TSet &&s) &&;
+  TSet operator~ (void) &&;
+  // операции на месте, мощность универса левого операнда сохраняется
+  TSet& operator+=(const TSet &s); // объединение
+  TSet& operator*=(const TSet &s); // пересечение
+  TSet& operator-=(const TSet &s); // разность
+  TSet& operator^=(const TSet &s); // симметрическая разность
+  // объединение/пересечение k множеств sets[0..k-1] за один проход
+  static TSet UnionAll(const TSet *const *sets, int k);
+  static TSet IntersectAll(const TSet *const *sets, int k);
+  // двоичный формат битового поля (см. tbitfield.h); Load устанавливает
+  // мощность универса из записи
+  size_t SaveSize(void) const;
+  void   Save(ostream &ostr) const;
+  size_t Save(void *buf, size_t size) const;
+  void   Load(istream &istr);
+  size_t Load(const void *buf, size_t size);
+
+  template <class> friend class TSetExpr;
+  friend class TRoaringSet;
 
   friend istream &operator>>(istream &istr, TSet &bf);
   friend ostream &operator<<(ostream &ostr, const TSet &bf);
 };
+
+#include "tsetexpr.h"
+
 #endif
@@ -0,0 +1,147 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tsetexpr.h
+//
+// Ленивые выражения над множествами
+//   выражение начинается с TSet::Lazy(); операции "+", "*", "~" строят
+//   дерево узлов из tbitexpr.h, которое вычисляется одним проходом по словам
+//   при преобразовании в TSet; подключается из tset.h
+
+#ifndef __SETEXPR_H__
+#define __SETEXPR_H__
+
+#include "tset.h"
+
+// выражение над множествами; кроме преобразования в множество
+// поддерживает запросы, вычисляемые без построения результата
+template <class E>
+class TSetExpr
+{
+public:
+  E Node; // корень дерева
+
+  explicit TSetExpr(const E &e) : Node(e) {}
+  static TBitLeaf<TELEM> Leaf(const TSet &s) { return TBitLeaf<TELEM>(s.BitField); }
+
+  int GetMaxPower(void) const { return Node.Length(); }  // мощность универса
+  int Cardinality(void) const { return TBitExpr<E>(Node).Count(); } // мощность
+  int IsMember(const int Elem) const { return TBitExpr<E>(Node).GetBit(Elem); }
+};
+
+// операции над выражениями и множествами
+
+template <class E1, class E2>
+inline TSetExpr<TBitOrNode<E1, E2> > operator+(const TSetExpr<E1> &a, const TSetExpr<E2> &b)
+{
+  return TSetExpr<TBitOrNode<E1, E2> >(TBitOrNode<E1, E2>(a.Node, b.Node));
+}
+
+template <class E>
+inline TSetExpr<TBitOrNode<E, TSet::TLeaf> > operator+(const TSetExpr<E> &a, const TSet &b)
+{
+  return TSetExpr<TBitOrNode<E, TSet::TLeaf> >(
+    TBitOrNode<E, TSet::TLeaf>(a.Node, TSetExpr<E>::Leaf(b)));
+}
+
+template <class E>
+inline TSetExpr<TBitOrNode<TSet::TLeaf, E> > operator+(const TSet &a, const TSetExpr<E> &b)
+{
+  return TSetExpr<TBitOrNode<TSet::TLeaf, E> >(
+    TBitOrNode<TSet::TLeaf, E>(TSetExpr<E>::Leaf(a), b.Node));
+}
+
+// временное множество разрушится раньше, чем будет вычислено выражение
+template <class E>
+void operator+(const TSetExpr<E> &a, TSet &&b) = delete;
+template <class E>
+void operator+(TSet &&a, const TSetExpr<E> &b) = delete;
+
+template <class E1, class E2>
+inline TSetExpr<TBitAndNode<E1, E2> > operator*(const TSetExpr<E1> &a, const TSetExpr<E2> &b)
+{
+  return TSetExpr<TBitAndNode<E1, E2> >(TBitAndNode<E1, E2>(a.Node, b.Node));
+}
+
+template <class E>
+inline TSetExpr<TBitAndNode<E, TSet::TLeaf> > operator*(const TSetExpr<E> &a, const TSet &b)
+{
+  return TSetExpr<TBitAndNode<E, TSet::TLeaf> >(
+    TBitAndNode<E, TSet::TLeaf>(a.Node, TSetExpr<E>::Leaf(b)));
+}
+
+template <class E>
+inline TSetExpr<TBitAndNode<TSet::TLeaf, E> > operator*(const TSet &a, const TSetExpr<E> &b)
+{
+  return TSetExpr<TBitAndNode<TSet::TLeaf, E> >(
+    TBitAndNode<TSet::TLeaf, E>(TSetExpr<E>::Leaf(a), b.Node));
+}
+
+// временное множество разрушится раньше, чем будет вычислено выражение
+template <class E>
+void operator*(const TSetExpr<E> &a, TSet &&b) = delete;
+template <class E>
+void operator*(TSet &&a, const TSetExpr<E> &b) = delete;
+
+template <class E>
+inline TSetExpr<TBitNotNode<E> > operator~(const TSetExpr<E> &a)
+{
+  return TSetExpr<TBitNotNode<E> >(TBitNotNode<E>(a.Node));
+}
+
+// операции с элементом вычисляют выражение
+template <class E>
+inline TSet operator+(const TSetExpr<E> &a, const int Elem)
+{
+  TSet res(a);
+  res.InsElem(Elem);
+  return res;
+}
+
+template <class E>
+inline TSet operator-(const TSetExpr<E> &a, const int Elem)
+{
+  TSet res(a);
+  res.DelElem(Elem);
+  return res;
+}
+
+template <class E>
+inline int operator==(const TSetExpr<E> &a, const TSet &b)
+{
+  return b == a;
+}
+
+template <class E>
+inline int operator!=(const TSetExpr<E> &a, const TSet &b)
+{
+  return b != a;
+}
+
+template <class E>
+inline ostream &operator<<(ostream &ostr, const TSetExpr<E> &e)
+{
+  return ostr << TSet(e);
+}
+
+// методы TSet, строящие и вычисляющие выражения
+
+inline TSetExpr<TSet::TLeaf> TSet::Lazy(void) const &
+{
+  return TSetExpr<TLeaf>(TLeaf(BitField));
+}
+
+template <class E>
+TSet::TSet(const TSetExpr<E> &e) : BitField(TBitExpr<E>(e.Node))
+{
+  MaxPower = BitField.GetLength();
+}
+
+template <class E>
+TSet& TSet::operator=(const TSetExpr<E> &e)
+{
+  BitField = TBitExpr<E>(e.Node);
+  MaxPower = BitField.GetLength();
+  return *this;
+}
+
+#endif
@@ -12,41 +12,34 @@
 
 #ifndef USE_SET // Использовать класс TBitField
 
-#include "tbitfield.h"
+#include "tprimesieve.h"
 
+#define SIEVE_THREADS 0 // к-во потоков решета: 0 - по к-ву ядер,
+                        // 1 - однопоточный перебор
+
+// печать простого числа, по 10 в строке
+static void PrintPrime(long long p, void *ctx)
+{
+  long long &count = *(long long *)ctx;
+  cout << setw(3) << p << " ";
+  if (++count % 10 == 0)
+    cout << endl;
+}
+
+// решето - TPrimeSieve: сегменты битовых полей, помещающиеся в кэш;
+// сегменты разных частей диапазона просеиваются параллельно
 int main()
 {
-  int n, m, k, count;
+  long long n, count;
 
   setlocale(LC_ALL, "Russian");
   cout << "Тестирование программ поддержки битового поля" << endl;
   cout << "             Решето Эратосфена" << endl;
   cout << "Введите верхнюю границу целых значений - ";
   cin  >> n;
-  TBitField s(n + 1);
-  // заполнение множества
-  for (m = 2; m <= n; m++)
-    s.SetBit(m);
-  // проверка до sqrt(n) и удаление кратных
-  for (m = 2; m * m <= n; m++)
-    // если m в s, удаление кратных
-    if (s.GetBit(m))
-      for (k = 2 * m; k <= n; k += m)
-        if (s.GetBit(k))
-          s.ClrBit(k);
-  // оставшиеся в s элементы - простые числа
-  cout << endl << "Печать множества некратных чисел" << endl << s << endl;
   cout << endl << "Печать простых чисел" << endl;
   count = 0;
-  k = 1;
-  for (m = 2; m <= n; m++)
-    if (s.GetBit(m))
-    {
-      count++;
-      cout << setw(3) << m << " ";
-      if (k++ % 10 == 0)
-        cout << endl;
-    }
+  TPrimeSieve::VisitPrimes(0, n, SIEVE_THREADS, PrintPrime, &count);
   cout << endl;
   cout << "В первых " << n << " числах " << count << " простых" << endl;
 }
@@ -77,16 +70,15 @@ int main()
   // оставшиеся в s элементы - простые числа
   cout << endl << "Печать множества некратных чисел" << endl << s << endl;
   cout << endl << "Печать простых чисел" << endl;
-  count = 0;
+  count = s.Cardinality();
   k = 1;
-  for (m = 2; m <= n; m++)
-    if (s.IsMember(m))
-    {
-      count++;
-      cout << setw(3) << m << " ";
-      if (k++ % 10 == 0)
-        cout << endl;
-    }
+  // перебор только установленных битов
+  for (int p : s)
+  {
+    cout << setw(3) << p << " ";
+    if (k++ % 10 == 0)
+      cout << endl;
+  }
   cout << endl;
   cout << "В первых " << n << " числах " << count << " простых" << endl;
 }
@@ -6,89 +6,1173 @@
 // Битовое поле
 
 #include "tbitfield.h"
+#include "tbitops.h"
 
-TBitField::TBitField(int len)
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// на little-endian машинах байты слов в памяти идут в порядке битов поля,
+// как в двоичном формате
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define BITFIELD_LITTLE_ENDIAN
+#endif
+
+template <class TWord>
+TBasicBitField<TWord>::TBasicBitField(int len, pmr::memory_resource *res)
 {
+  Changes = 0;
+  if (len < 0)
+    throw invalid_argument("negative bitfield length");
+  pRes = res;
+  BitLen = len;
+  MemLen = (len + BitsInElem - 1) / BitsInElem;
+  pMem = Allocate(MemLen);
+  BitZero(pMem, MemLen); // длинное поле заполняется частями в потоках пула
 }
 
-TBitField::TBitField(const TBitField &bf) // конструктор копирования
+template <class TWord>
+TBasicBitField<TWord>::TBasicBitField(const TBasicBitField &bf) // конструктор копирования
 {
+  Changes = 0;
+  pRes = bf.pRes;
+  BitLen = bf.BitLen;
+  MemLen = bf.MemLen;
+  pMem = Allocate(MemLen);
+  BitCopy(pMem, bf.pMem, MemLen);
 }
 
-TBitField::~TBitField()
+template <class TWord>
+TBasicBitField<TWord>::TBasicBitField(const TBasicBitField &bf, pmr::memory_resource *res)
 {
+  Changes = 0;
+  pRes = res;
+  BitLen = bf.BitLen;
+  MemLen = bf.MemLen;
+  pMem = Allocate(MemLen);
+  BitCopy(pMem, bf.pMem, MemLen);
 }
 
-int TBitField::GetMemIndex(const int n) const // индекс Мем для бита n
+template <class TWord>
+TBasicBitField<TWord>::TBasicBitField(TBasicBitField &&bf) // конструктор перемещения
 {
-    return 0;
+  Changes = 0;
+  pRes = bf.pRes;
+  pMem = Local;
+  Steal(bf);
+}
+
+template <class TWord>
+TBasicBitField<TWord>::~TBasicBitField()
+{
+  Release();
+}
+
+template <class TWord>
+pmr::memory_resource *TBasicBitField<TWord>::GetResource(void) const // источник памяти
+{
+  return pRes;
+}
+
+template <class TWord>
+TWord *TBasicBitField<TWord>::Allocate(const int n) // память для n эл-тов
+{
+  if (n <= LocalLen)
+    return Local;
+  return (TWord *)pRes->allocate(n * sizeof(TWord), alignof(TWord));
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::Release(void) // вернуть память в pRes
+{
+  if (pMem != Local)
+    pRes->deallocate(pMem, MemLen * sizeof(TWord), alignof(TWord));
 }
 
-TELEM TBitField::GetMemMask(const int n) const // битовая маска для бита n
+template <class TWord>
+void TBasicBitField<TWord>::Steal(TBasicBitField &bf) // перенять память bf
 {
-    return TELEM();
+  Changes++;
+  bf.Changes++;
+  // память из pRes передается, встроенная - копируется; текущая память
+  // должна быть уже освобождена, а ресурсы полей - совпадать
+  BitLen = bf.BitLen;
+  MemLen = bf.MemLen;
+  if (bf.pMem == bf.Local)
+  {
+    pMem = Local;
+    memcpy(Local, bf.Local, MemLen * sizeof(TWord));
+  }
+  else
+    pMem = bf.pMem;
+  bf.BitLen = 0;
+  bf.MemLen = 0;
+  bf.pMem = bf.Local;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::Resize(const int len) // новая длина
+{
+  Changes++;
+  // память сохраняется, если к-во слов не меняется
+  int n = (len + BitsInElem - 1) / BitsInElem;
+  if (n != MemLen)
+  {
+    Release();
+    BitLen = MemLen = 0;
+    pMem = Local;
+    pMem = Allocate(n);
+    MemLen = n;
+  }
+  BitLen = len;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::GetMemIndex(const int n) const // индекс Мем для бита n
+{
+  return n / BitsInElem;
+}
+
+template <class TWord>
+TWord TBasicBitField<TWord>::GetMemMask(const int n) const // битовая маска для бита n
+{
+  return TWord(1) << (n % BitsInElem);
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::ClearTail(void) // обнулить биты за пределами BitLen
+{
+  if (BitLen % BitsInElem != 0)
+    pMem[MemLen - 1] &= GetMemMask(BitLen) - 1;
 }
 
 // доступ к битам битового поля
 
-int TBitField::GetLength(void) const // получить длину (к-во битов)
+template <class TWord>
+int TBasicBitField<TWord>::GetLength(void) const // получить длину (к-во битов)
 {
-  return 0;
+  return BitLen;
 }
 
-void TBitField::SetBit(const int n) // установить бит
+template <class TWord>
+void TBasicBitField<TWord>::SetBit(const int n) // установить бит
 {
+  Changes++;
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  pMem[GetMemIndex(n)] |= GetMemMask(n);
 }
 
-void TBitField::ClrBit(const int n) // очистить бит
+template <class TWord>
+void TBasicBitField<TWord>::ClrBit(const int n) // очистить бит
 {
+  Changes++;
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  pMem[GetMemIndex(n)] &= ~GetMemMask(n);
 }
 
-int TBitField::GetBit(const int n) const // получить значение бита
+template <class TWord>
+int TBasicBitField<TWord>::GetBit(const int n) const // получить значение бита
 {
-  return 0;
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  return (pMem[GetMemIndex(n)] & GetMemMask(n)) != 0;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::Count(void) const // к-во установленных битов
+{
+  return BitCount(pMem, MemLen);
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::RangeWords(const int lo, const int hi, int &first, int &last,
+                                      TWord &head, TWord &tail) const // слова диапазона
+{
+  if ((lo < 0) || (lo > hi) || (hi > BitLen))
+    throw out_of_range("bit range out of range");
+  if (lo == hi)
+    return 0;
+  first = GetMemIndex(lo);
+  last = GetMemIndex(hi - 1);
+  head = ~(GetMemMask(lo) - 1);         // биты lo и старше
+  tail = (GetMemMask(hi - 1) << 1) - 1; // биты hi-1 и младше
+  if (first == last)
+    head = tail = head & tail;
+  return 1;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::CountRange(const int lo, const int hi) const // к-во в lo..hi-1
+{
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return 0;
+  if (first == last)
+  {
+    TWord w = pMem[first] & head;
+    return BitCount(&w, 1);
+  }
+  TWord w[2] = { pMem[first] & head, pMem[last] & tail };
+  return BitCount(w, 2) + BitCount(pMem + first + 1, last - first - 1);
+}
+
+// операции над диапазоном битов
+
+template <class TWord>
+void TBasicBitField<TWord>::SetRange(const int lo, const int hi) // установить биты lo..hi-1
+{
+  Changes++;
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return;
+  pMem[first] |= head;
+  if (first == last)
+    return;
+  memset(pMem + first + 1, 0xff, (last - first - 1) * sizeof(TWord));
+  pMem[last] |= tail;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::ClrRange(const int lo, const int hi) // очистить биты lo..hi-1
+{
+  Changes++;
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return;
+  pMem[first] &= ~head;
+  if (first == last)
+    return;
+  BitZero(pMem + first + 1, last - first - 1);
+  pMem[last] &= ~tail;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::FlipRange(const int lo, const int hi) // инвертировать биты lo..hi-1
+{
+  Changes++;
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return;
+  pMem[first] ^= head;
+  if (first == last)
+    return;
+  BitNot(pMem + first + 1, pMem + first + 1, last - first - 1);
+  pMem[last] ^= tail;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::AllInRange(const int lo, const int hi) const // все биты lo..hi-1
+{
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return 1;
+  if ((pMem[first] & head) != head)
+    return 0;
+  if (first == last)
+    return 1;
+  for (int i = first + 1; i < last; i++)
+    if (pMem[i] != TWord(~TWord(0)))
+      return 0;
+  return (pMem[last] & tail) == tail;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::AnyInRange(const int lo, const int hi) const // хотя бы один бит
+{
+  int first, last;
+  TWord head, tail;
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return 0;
+  if (pMem[first] & head)
+    return 1;
+  if (first == last)
+    return 0;
+  for (int i = first + 1; i < last; i++)
+    if (pMem[i] != 0)
+      return 1;
+  return (pMem[last] & tail) != 0;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::CopyBits(TWord *dst, int n, const TWord *src, int srcLen, int off)
+{
+  int m = (n < srcLen) ? n : srcLen; // слова, начинающиеся в src
+  if (off == 0)
+  {
+    memcpy(dst, src, m * sizeof(TWord));
+    if (m < n)
+      BitZero(dst + m, n - m);
+    return;
+  }
+  // слово результата сливается из двух смежных слов src (funnel shift)
+  int full = (m < srcLen) ? m : m - 1; // слова, за которыми в src есть следующее
+  for (int i = 0; i < full; i++)
+    dst[i] = (src[i] >> off) | (src[i + 1] << (BitsInElem - off));
+  if ((full >= 0) && (full < m))
+    dst[full] = src[m - 1] >> off;
+  if (m < n)
+    BitZero(dst + m, n - m);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::Extract(const int lo, const int hi) const // копия lo..hi-1
+{
+  int first, last;
+  TWord head, tail;
+  TBasicBitField res(0, pRes);
+  if (!RangeWords(lo, hi, first, last, head, tail))
+    return res;
+  res.Resize(hi - lo); // слова записываются копированием, без обнуления
+  CopyBits(res.pMem, res.MemLen, pMem + first, MemLen - first, lo % BitsInElem);
+  res.ClearTail();
+  return res;
+}
+
+// поиск установленных битов
+
+template <class TWord>
+int TBasicBitField<TWord>::FindFirst(void) const // первый установленный бит
+{
+  return FindNext(-1);
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::FindLast(void) const // последний установленный бит
+{
+  return FindPrev(BitLen);
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::FindNext(const int n) const // первый установленный после n
+{
+  if ((n < -1) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  int p = n + 1;
+  if (p == BitLen)
+    return -1;
+  int i = GetMemIndex(p);
+  TWord w = pMem[i] & ~(GetMemMask(p) - 1); // отбросить биты до p
+  while (w == 0)
+  {
+    if (++i == MemLen)
+      return -1;
+    w = pMem[i];
+  }
+  return i * BitsInElem + BitLowest(w);
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::FindPrev(const int n) const // последний установленный до n
+{
+  if ((n < 0) || (n > BitLen))
+    throw out_of_range("bit index out of range");
+  if (n == 0)
+    return -1;
+  int p = n - 1;
+  int i = GetMemIndex(p);
+  TWord w = pMem[i] & ((GetMemMask(p) << 1) - 1); // отбросить биты после p
+  while (w == 0)
+  {
+    if (--i < 0)
+      return -1;
+    w = pMem[i];
+  }
+  return i * BitsInElem + BitHighest(w);
+}
+
+template <class TWord>
+TBasicBitIterator<TWord> TBasicBitField<TWord>::begin(void) const
+{
+  return TBasicBitIterator<TWord>(this, FindFirst());
+}
+
+template <class TWord>
+TBasicBitIterator<TWord> TBasicBitField<TWord>::end(void) const
+{
+  return TBasicBitIterator<TWord>(this, -1);
 }
 
 // битовые операции
 
-TBitField& TBitField::operator=(const TBitField &bf) // присваивание
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator=(const TBasicBitField &bf) // присваивание
 {
+  Changes++;
+  if (this == &bf)
     return *this;
+  if (MemLen != bf.MemLen)
+  {
+    TWord *p = Allocate(bf.MemLen);
+    if (p != pMem)
+      Release();
+    pMem = p;
+    MemLen = bf.MemLen;
+  }
+  BitLen = bf.BitLen;
+  BitCopy(pMem, bf.pMem, MemLen);
+  return *this;
 }
 
-int TBitField::operator==(const TBitField &bf) const // сравнение
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator=(TBasicBitField &&bf) // присваивание с перемещением
 {
-  return 0;
+  if (this == &bf)
+    return *this;
+  if ((pRes != bf.pRes) && !(*pRes == *bf.pRes))
+    return *this = static_cast<const TBasicBitField &>(bf); // память из чужого ресурса копируется
+  Release();
+  Steal(bf);
+  return *this;
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::operator==(const TBasicBitField &bf) const // сравнение
+{
+  // неиспользуемые биты последнего эл-та Мем всегда нулевые,
+  // поэтому поля достаточно сравнить поэлементно
+  if (BitLen != bf.BitLen)
+    return 0;
+  return BitEqual(pMem, bf.pMem, MemLen);
+}
+
+template <class TWord>
+int TBasicBitField<TWord>::operator!=(const TBasicBitField &bf) const // сравнение
+{
+  return !(*this == bf);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator|(const TBasicBitField &bf) const & // операция "или"
+{
+  // длина результата - большая из длин, недостающие биты считаются нулевыми
+  const TBasicBitField &lng = (BitLen >= bf.BitLen) ? *this : bf;
+  const TBasicBitField &shr = (BitLen >= bf.BitLen) ? bf : *this;
+  TBasicBitField res(0, pRes);
+  res.Resize(lng.BitLen); // все слова результата записываются ниже
+  BitOr(res.pMem, lng.pMem, shr.pMem, shr.MemLen);
+  memcpy(res.pMem + shr.MemLen, lng.pMem + shr.MemLen,
+         (lng.MemLen - shr.MemLen) * sizeof(TWord));
+  return res;
 }
 
-int TBitField::operator!=(const TBitField &bf) const // сравнение
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator&(const TBasicBitField &bf) const & // операция "и"
+{
+  // длина результата - большая из длин, хвост результата остается нулевым
+  const TBasicBitField &lng = (BitLen >= bf.BitLen) ? *this : bf;
+  const TBasicBitField &shr = (BitLen >= bf.BitLen) ? bf : *this;
+  TBasicBitField res(lng.BitLen, pRes);
+  BitAnd(res.pMem, lng.pMem, shr.pMem, shr.MemLen);
+  return res;
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator~(void) const & // отрицание
+{
+  TBasicBitField res(0, pRes);
+  res.Resize(BitLen);
+  BitNot(res.pMem, pMem, MemLen);
+  res.ClearTail(); // биты за пределами BitLen должны остаться нулевыми
+  return res;
+}
+
+// операции над временными операндами: если временный операнд не короче
+// другого, результат вычисляется на месте в его памяти
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator|(const TBasicBitField &bf) &&
 {
+  if (BitLen < bf.BitLen)
+    return static_cast<const TBasicBitField &>(*this) | bf;
+  *this |= bf;
+  return std::move(*this);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator|(TBasicBitField &&bf) const &
+{
+  return std::move(bf) | *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator|(TBasicBitField &&bf) &&
+{
+  if (BitLen < bf.BitLen)
+    return std::move(bf) | *this;
+  return std::move(*this) | static_cast<const TBasicBitField &>(bf);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator&(const TBasicBitField &bf) &&
+{
+  if (BitLen < bf.BitLen)
+    return static_cast<const TBasicBitField &>(*this) & bf;
+  *this &= bf;
+  return std::move(*this);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator&(TBasicBitField &&bf) const &
+{
+  return std::move(bf) & *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator&(TBasicBitField &&bf) &&
+{
+  if (BitLen < bf.BitLen)
+    return std::move(bf) & *this;
+  return std::move(*this) & static_cast<const TBasicBitField &>(bf);
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator~(void) &&
+{
+  BitNot(pMem, pMem, MemLen);
+  ClearTail();
+  return std::move(*this);
+}
+
+// операции на месте
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator|=(const TBasicBitField &bf) // "или"
+{
+  Changes++;
+  int n = (MemLen < bf.MemLen) ? MemLen : bf.MemLen;
+  BitOr(pMem, pMem, bf.pMem, n);
+  ClearTail();
+  return *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator&=(const TBasicBitField &bf) // "и"
+{
+  Changes++;
+  int n = (MemLen < bf.MemLen) ? MemLen : bf.MemLen;
+  BitAnd(pMem, pMem, bf.pMem, n);
+  BitZero(pMem + n, MemLen - n);
+  return *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator^=(const TBasicBitField &bf) // "исключающее или"
+{
+  Changes++;
+  int n = (MemLen < bf.MemLen) ? MemLen : bf.MemLen;
+  BitXor(pMem, pMem, bf.pMem, n);
+  ClearTail();
+  return *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator-=(const TBasicBitField &bf) // "и-не" (разность)
+{
+  Changes++;
+  int n = (MemLen < bf.MemLen) ? MemLen : bf.MemLen;
+  BitAndNot(pMem, pMem, bf.pMem, n);
+  return *this;
+}
+
+// сдвиги
+
+// dst = src, сдвинутое на k битов к старшим (n слов); при Or результат
+// объединяется с dst, иначе освободившиеся младшие слова обнуляются;
+// проход от старших слов к младшим допускает dst == src
+template <int Or, class TWord>
+static void ShiftUpWords(TWord *dst, const TWord *src, int n, int k)
+{
+  const int bits = sizeof(TWord) * 8;
+  int ws = k / bits, bs = k % bits;
+  if (ws >= n)
+  {
+    if (!Or)
+      BitZero(dst, n);
+    return;
+  }
+  if (Or || bs)
+  {
+    // смежные слова сливаются (funnel shift); при bs == 0 - просто копия
+    for (int i = n - 1; i > ws; i--)
+    {
+      TWord w = bs ? (src[i - ws] << bs) | (src[i - ws - 1] >> (bits - bs)) : src[i - ws];
+      dst[i] = Or ? dst[i] | w : w;
+    }
+    dst[ws] = Or ? dst[ws] | (src[0] << bs) : src[0] << bs;
+  }
+  else
+    memmove(dst + ws, src, (n - ws) * sizeof(TWord));
+  if (!Or)
+    BitZero(dst, ws);
+}
+
+// dst = src, сдвинутое на k битов к младшим; проход от младших слов к
+// старшим допускает dst == src
+template <int Or, class TWord>
+static void ShiftDownWords(TWord *dst, const TWord *src, int n, int k)
+{
+  const int bits = sizeof(TWord) * 8;
+  int ws = k / bits, bs = k % bits;
+  if (ws >= n)
+  {
+    if (!Or)
+      BitZero(dst, n);
+    return;
+  }
+  if (Or || bs)
+  {
+    for (int i = 0; i < n - ws - 1; i++)
+    {
+      TWord w = bs ? (src[i + ws] >> bs) | (src[i + ws + 1] << (bits - bs)) : src[i + ws];
+      dst[i] = Or ? dst[i] | w : w;
+    }
+    dst[n - ws - 1] = Or ? dst[n - ws - 1] | (src[n - 1] >> bs) : src[n - 1] >> bs;
+  }
+  else
+    memmove(dst, src + ws, (n - ws) * sizeof(TWord));
+  if (!Or)
+    BitZero(dst + n - ws, ws);
+}
+
+static void CheckShift(const int k)
+{
+  if (k < 0)
+    throw invalid_argument("negative shift");
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator<<(const int k) const // сдвиг влево
+{
+  CheckShift(k);
+  TBasicBitField res(0, pRes);
+  res.Resize(BitLen); // слова записываются сдвигом, без обнуления
+  ShiftUpWords<0>(res.pMem, pMem, MemLen, k);
+  res.ClearTail();
+  return res;
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::operator>>(const int k) const // сдвиг вправо
+{
+  CheckShift(k);
+  TBasicBitField res(0, pRes);
+  res.Resize(BitLen);
+  ShiftDownWords<0>(res.pMem, pMem, MemLen, k);
+  return res;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator<<=(const int k)
+{
+  return ShiftLeft(k);
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::operator>>=(const int k)
+{
+  return ShiftRight(k);
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::ShiftLeft(const int k) // сдвиг влево на месте
+{
+  Changes++;
+  CheckShift(k);
+  ShiftUpWords<0>(pMem, pMem, MemLen, k);
+  ClearTail();
+  return *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::ShiftRight(const int k) // сдвиг вправо на месте
+{
+  Changes++;
+  CheckShift(k);
+  ShiftDownWords<0>(pMem, pMem, MemLen, k);
+  return *this;
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::RotateLeft(const int k) // циклический сдвиг влево
+{
+  CheckShift(k);
+  if (BitLen == 0)
+    return *this;
+  int r = k % BitLen;
+  if (r == 0)
+    return *this;
+  // (x << r) | (x >> (BitLen - r)): два прохода по новой памяти
+  TBasicBitField res(0, pRes);
+  res.Resize(BitLen);
+  ShiftUpWords<0>(res.pMem, pMem, MemLen, r);
+  res.ClearTail();
+  ShiftDownWords<1>(res.pMem, pMem, MemLen, BitLen - r);
+  return *this = std::move(res);
+}
+
+template <class TWord>
+TBasicBitField<TWord>& TBasicBitField<TWord>::RotateRight(const int k) // циклический сдвиг вправо
+{
+  CheckShift(k);
+  if (BitLen == 0)
+    return *this;
+  return RotateLeft(BitLen - k % BitLen);
+}
+
+// операции над многими полями
+
+// к-во слов в блоке: блок результата и блок очередного операнда вместе
+// помещаются в кэш L1
+static const int MultiBlockBytes = 8192;
+
+template <class TWord>
+static int MaxLength(const TBasicBitField<TWord> *const *f, int k)
+{
+  if (k < 0)
+    throw invalid_argument("negative operand count");
+  int len = 0;
+  for (int j = 0; j < k; j++)
+    if (f[j]->GetLength() > len)
+      len = f[j]->GetLength();
+  return len;
+}
+
+template <class TWord>
+static int AnySet(const TWord *p, int n) // есть ли ненулевое слово в p[0..n-1]
+{
+  for (int i = 0; i < n; i++)
+    if (p[i] != 0)
+      return 1;
   return 0;
 }
 
-TBitField TBitField::operator|(const TBitField &bf) // операция "или"
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::UnionAll(const TBasicBitField *const *f, int k)
+{
+  TBasicBitField res(MaxLength(f, k), (k > 0) ? f[0]->pRes : pmr::get_default_resource());
+  const int block = MultiBlockBytes / sizeof(TWord);
+  for (int lo = 0; lo < res.MemLen; lo += block)
+  {
+    int hi = (lo + block < res.MemLen) ? lo + block : res.MemLen;
+    for (int j = 0; j < k; j++)
+    {
+      int n = ((hi < f[j]->MemLen) ? hi : f[j]->MemLen) - lo;
+      if (n > 0)
+        BitOr(res.pMem + lo, res.pMem + lo, f[j]->pMem + lo, n);
+    }
+  }
+  return res;
+}
+
+template <class TWord>
+TBasicBitField<TWord> TBasicBitField<TWord>::IntersectAll(const TBasicBitField *const *f, int k)
+{
+  int len = MaxLength(f, k);
+  TBasicBitField res(0, (k > 0) ? f[0]->pRes : pmr::get_default_resource());
+  if (k == 0)
+    return res;
+  res.Resize(len); // слова записываются копированием, без обнуления
+  // за пределами самого короткого поля результат нулевой
+  int common = f[0]->MemLen;
+  for (int j = 1; j < k; j++)
+    if (f[j]->MemLen < common)
+      common = f[j]->MemLen;
+  BitZero(res.pMem + common, res.MemLen - common);
+  const int block = MultiBlockBytes / sizeof(TWord);
+  for (int lo = 0; lo < common; lo += block)
+  {
+    int n = ((lo + block < common) ? lo + block : common) - lo;
+    TWord *p = res.pMem + lo;
+    memcpy(p, f[0]->pMem + lo, n * sizeof(TWord));
+    for (int j = 1; j < k; j++)
+    {
+      BitAnd(p, p, f[j]->pMem + lo, n);
+      if (!AnySet(p, n)) // блок обнулился - остальные поля не читаются
+        break;
+    }
+  }
+  return res;
+}
+
+// двоичный формат
+
+static const char BinMagic[4] = { 'T', 'B', 'I', 'T' };
+static const int BinVersion = 1;
+
+static void PutLE(unsigned char *p, unsigned long long x, int n) // n младших байтов x
+{
+  for (int j = 0; j < n; j++)
+    p[j] = (unsigned char)(x >> (8 * j));
+}
+
+static unsigned long long GetLE(const unsigned char *p, int n)
+{
+  unsigned long long x = 0;
+  for (int j = 0; j < n; j++)
+    x |= (unsigned long long)p[j] << (8 * j);
+  return x;
+}
+
+static unsigned long long GetLE64(const unsigned char *p)
+{
+#ifdef BITFIELD_LITTLE_ENDIAN
+  unsigned long long x;
+  memcpy(&x, p, sizeof(x));
+  return x;
+#else
+  return GetLE(p, 8);
+#endif
+}
+
+// сумма Флетчера по 64-битным словам: s1 - сумма слов, s2 - сумма s1;
+// s2 зависит от порядка слов; при dst != 0 байты попутно копируются в dst
+// (за один проход по памяти вместо двух)
+static unsigned long long BinChecksum(unsigned long long len, const unsigned char *p, size_t n,
+                                      unsigned char *dst = 0)
+{
+  unsigned long long s1 = len, s2 = 0;
+  size_t i = 0;
+  if (dst)
+    for (; i + 8 <= n; i += 8)
+    {
+      unsigned long long w = GetLE64(p + i);
+      memcpy(dst + i, p + i, 8);
+      s1 += w;
+      s2 += s1;
+    }
+  for (; i + 8 <= n; i += 8)
+  {
+    s1 += GetLE64(p + i);
+    s2 += s1;
+  }
+  if (i < n) // неполное последнее слово дополняется нулями
+  {
+    unsigned char t[8] = { 0 };
+    memcpy(t, p + i, n - i);
+    if (dst)
+      memcpy(dst + i, t, n - i);
+    s1 += GetLE64(t);
+    s2 += s1;
+  }
+  return s1 ^ ((s2 << 32) | (s2 >> 32));
+}
+
+static void PutHeader(unsigned char *h, unsigned long long len, unsigned long long sum)
+{
+  memcpy(h, BinMagic, 4);
+  PutLE(h + 4, BinVersion, 2);
+  PutLE(h + 6, 0, 2);
+  PutLE(h + 8, len, 8);
+  PutLE(h + 16, sum, 8);
+}
+
+// проверить заголовок, вернуть длину поля
+static int GetHeader(const unsigned char *h, unsigned long long &sum)
+{
+  if (memcmp(h, BinMagic, 4) != 0)
+    throw runtime_error("not a binary bitfield");
+  if (GetLE(h + 4, 2) != (unsigned long long)BinVersion)
+    throw runtime_error("unsupported binary bitfield version");
+  unsigned long long len = GetLE(h + 8, 8);
+  if (len > (unsigned long long)INT_MAX)
+    throw runtime_error("binary bitfield is too long");
+  sum = GetLE(h + 16, 8);
+  return (int)len;
+}
+
+// байты поля <-> слова; на little-endian машинах - простое копирование
+template <class TWord>
+static void WordsToBytes(unsigned char *dst, const TWord *src, size_t bytes)
+{
+#ifdef BITFIELD_LITTLE_ENDIAN
+  memcpy(dst, src, bytes);
+#else
+  for (size_t j = 0; j < bytes; j++)
+    dst[j] = (unsigned char)(src[j / sizeof(TWord)] >> (8 * (j % sizeof(TWord))));
+#endif
+}
+
+template <class TWord>
+static void BytesToWords(TWord *dst, const unsigned char *src, size_t bytes)
 {
-    return TBitField(0);
+#ifdef BITFIELD_LITTLE_ENDIAN
+  memcpy(dst, src, bytes);
+#else
+  for (size_t j = 0; j < bytes; j += sizeof(TWord))
+  {
+    TWord w = 0;
+    for (size_t b = 0; (b < sizeof(TWord)) && (j + b < bytes); b++)
+      w |= TWord(src[j + b]) << (8 * b);
+    dst[j / sizeof(TWord)] = w;
+  }
+#endif
 }
 
-TBitField TBitField::operator&(const TBitField &bf) // операция "и"
+template <class TWord>
+int TBasicBitField<TWord>::SavedLength(const void *buf, size_t size, int check) // длина из записи
 {
-    return TBitField(0);
+  const unsigned char *h = (const unsigned char *)buf;
+  if (size < SavedHeaderSize)
+    throw runtime_error("truncated binary bitfield");
+  unsigned long long sum;
+  int len = GetHeader(h, sum);
+  size_t bytes = ((size_t)len + 7) / 8;
+  if (size - SavedHeaderSize < bytes)
+    throw runtime_error("truncated binary bitfield");
+  if (check && (BinChecksum(len, h + SavedHeaderSize, bytes) != sum))
+    throw runtime_error("binary bitfield checksum mismatch");
+  return len;
 }
 
-TBitField TBitField::operator~(void) // отрицание
+template <class TWord>
+size_t TBasicBitField<TWord>::SaveSize(void) const // размер записи
 {
-    return TBitField(0);
+  return SavedHeaderSize + ((size_t)BitLen + 7) / 8;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::Save(ostream &ostr) const // запись в поток
+{
+  size_t bytes = ((size_t)BitLen + 7) / 8;
+#ifdef BITFIELD_LITTLE_ENDIAN
+  const unsigned char *p = (const unsigned char *)pMem; // без промежуточной копии
+#else
+  vector<unsigned char> tmp(bytes);
+  WordsToBytes(tmp.data(), pMem, bytes);
+  const unsigned char *p = tmp.data();
+#endif
+  unsigned char h[SavedHeaderSize];
+  PutHeader(h, BitLen, BinChecksum(BitLen, p, bytes));
+  ostr.write((const char *)h, SavedHeaderSize);
+  ostr.write((const char *)p, bytes);
+}
+
+template <class TWord>
+size_t TBasicBitField<TWord>::Save(void *buf, size_t size) const // запись в буфер
+{
+  size_t bytes = ((size_t)BitLen + 7) / 8;
+  if (size < SavedHeaderSize + bytes)
+    throw invalid_argument("buffer is too small");
+  unsigned char *h = (unsigned char *)buf;
+#ifdef BITFIELD_LITTLE_ENDIAN
+  unsigned long long sum = BinChecksum(BitLen, (const unsigned char *)pMem, bytes, h + SavedHeaderSize);
+#else
+  WordsToBytes(h + SavedHeaderSize, pMem, bytes);
+  unsigned long long sum = BinChecksum(BitLen, h + SavedHeaderSize, bytes);
+#endif
+  PutHeader(h, BitLen, sum);
+  return SavedHeaderSize + bytes;
+}
+
+template <class TWord>
+void TBasicBitField<TWord>::Load(istream &istr) // чтение из потока
+{
+  unsigned char h[SavedHeaderSize];
+  if (!istr.read((char *)h, SavedHeaderSize))
+    throw runtime_error("truncated binary bitfield");
+  unsigned long long sum;
+  int len = GetHeader(h, sum);
+  size_t bytes = ((size_t)len + 7) / 8;
+  // запись читается в новое поле, при ошибке *this не меняется
+  TBasicBitField res(0, pRes);
+  res.Resize(len);
+  if (res.MemLen > 0)
+    res.pMem[res.MemLen - 1] = 0; // байты последнего слова за пределами записи
+#ifdef BITFIELD_LITTLE_ENDIAN
+  unsigned char *p = (unsigned char *)res.pMem; // чтение прямо в память поля
+#else
+  vector<unsigned char> tmp(bytes);
+  unsigned char *p = tmp.data();
+#endif
+  int ok = (bool)istr.read((char *)p, bytes) && (BinChecksum(len, p, bytes) == sum);
+  if (!ok)
+    throw runtime_error(istr ? "binary bitfield checksum mismatch" : "truncated binary bitfield");
+  if (p != (unsigned char *)res.pMem)
+    BytesToWords(res.pMem, p, bytes);
+  res.ClearTail();
+  *this = std::move(res);
+}
+
+template <class TWord>
+size_t TBasicBitField<TWord>::Load(const void *buf, size_t size) // чтение из буфера
+{
+  const unsigned char *h = (const unsigned char *)buf;
+  int len = SavedLength(buf, size, 0);
+  unsigned long long sum = GetLE(h + 16, 8);
+  size_t bytes = ((size_t)len + 7) / 8;
+  TBasicBitField res(0, pRes); // при ошибке *this не меняется
+  res.Resize(len);
+  if (res.MemLen > 0)
+    res.pMem[res.MemLen - 1] = 0;
+#ifdef BITFIELD_LITTLE_ENDIAN
+  int ok = BinChecksum(len, h + SavedHeaderSize, bytes, (unsigned char *)res.pMem) == sum;
+#else
+  int ok = BinChecksum(len, h + SavedHeaderSize, bytes) == sum;
+  if (ok)
+    BytesToWords(res.pMem, h + SavedHeaderSize, bytes);
+#endif
+  if (!ok)
+    throw runtime_error("binary bitfield checksum mismatch");
+  res.ClearTail();
+  *this = std::move(res);
+  return SavedHeaderSize + bytes;
 }
 
 // ввод/вывод
 
-istream &operator>>(istream &istr, TBitField &bf) // ввод
+// 8 символов '0'/'1' из p - в байт (символ p[j] - бит j); -1, если среди
+// них есть другие символы
+static int PackBits8(const char *p)
+{
+#ifdef BITFIELD_LITTLE_ENDIAN
+  unsigned long long x;
+  memcpy(&x, p, sizeof(x));
+  x ^= 0x3030303030303030ull; // '0' -> 0, '1' -> 1
+  if (x & 0xfefefefefefefefeull)
+    return -1;
+  // каждый байт 0 или 1: умножение собирает младшие биты байтов в старший байт
+  return (int)((x * 0x0102040810204080ull) >> 56);
+#else
+  int r = 0;
+  for (int j = 0; j < 8; j++)
+  {
+    unsigned int b = (unsigned int)(p[j] - '0');
+    if (b > 1)
+      return -1;
+    r |= b << j;
+  }
+  return r;
+#endif
+}
+
+template <class TWord>
+istream &operator>>(istream &istr, TBasicBitField<TWord> &bf) // ввод
 {
+  bf.Changes++;
+  // формат: строка из символов '0' и '1', бит 0 - первый символ;
+  // чтение прекращается на первом другом символе или после BitLen символов
+  const int bitsInElem = sizeof(TWord) * 8, eof = char_traits<char>::eof();
+  BitZero(bf.pMem, bf.MemLen);
+  if (!(istr >> ws))
     return istr;
+  // символы забираются блоками из буфера потока (sgetn не больше in_avail -
+  // без обращения к устройству) и переводятся в биты по 8; символы после
+  // конца строки битов возвращаются в буфер
+  streambuf *sb = istr.rdbuf();
+  char buf[1024];
+  int i = 0;
+  while (i < bf.BitLen)
+  {
+    int c = sb->sgetc();
+    if (c == eof)
+    {
+      istr.setstate(ios::eofbit);
+      break;
+    }
+    streamsize m = sb->in_avail();
+    if (m > (streamsize)sizeof(buf))
+      m = sizeof(buf);
+    if (m > bf.BitLen - i)
+      m = bf.BitLen - i;
+    m -= m % 8;
+    if (m == 0) // по одному символу
+    {
+      if ((c != '0') && (c != '1'))
+        break;
+      if (c == '1')
+        bf.pMem[i / bitsInElem] |= TWord(1) << (i % bitsInElem);
+      sb->sbumpc();
+      i++;
+      continue;
+    }
+    sb->sgetn(buf, m);
+    int k = 0, b;
+    for (; (k < m) && ((b = PackBits8(buf + k)) >= 0); k += 8)
+    {
+      int n = i + k, off = n % bitsInElem;
+      bf.pMem[n / bitsInElem] |= TWord(b) << off;
+      if (off > bitsInElem - 8)
+        bf.pMem[n / bitsInElem + 1] |= TWord(b) >> (bitsInElem - off);
+    }
+    for (; (k < m) && ((buf[k] == '0') || (buf[k] == '1')); k++)
+      if (buf[k] == '1')
+        bf.pMem[(i + k) / bitsInElem] |= TWord(1) << ((i + k) % bitsInElem);
+    for (streamsize t = m; t > k; t--)
+      sb->sungetc();
+    i += k;
+    if (k < m)
+      break;
+  }
+  return istr;
+}
+
+// символы '0'/'1' для каждого значения байта, младший бит - первым
+struct TByteChars
+{
+  char Chars[256][8];
+
+  TByteChars()
+  {
+    for (int b = 0; b < 256; b++)
+      for (int k = 0; k < 8; k++)
+        Chars[b][k] = ((b >> k) & 1) ? '1' : '0';
+  }
+};
+
+// таблица строится при первом выводе
+static const TByteChars &ByteChars(void)
+{
+  static const TByteChars table;
+  return table;
 }
 
-ostream &operator<<(ostream &ostr, const TBitField &bf) // вывод
+static const int OutBufSize = 4096; // буфер вывода на стеке
+
+template <class TWord>
+ostream &operator<<(ostream &ostr, const TBasicBitField<TWord> &bf) // вывод
 {
-    return ostr;
+  // слова переводятся в символы по таблице байтов в буфер, который
+  // передается потоку одним вызовом write
+  char buf[OutBufSize];
+  const char (*chars)[8] = ByteChars().Chars;
+  const int wordChars = sizeof(TWord) * 8;
+  int full = bf.BitLen / wordChars, len = 0;
+  for (int i = 0; i < full; i++)
+  {
+    TWord w = bf.pMem[i];
+    for (size_t k = 0; k < sizeof(TWord); k++, w >>= 8)
+      memcpy(buf + len + 8 * k, chars[(unsigned char)w], 8);
+    len += wordChars;
+    if (len + wordChars > OutBufSize)
+    {
+      ostr.write(buf, len);
+      len = 0;
+    }
+  }
+  for (int i = full * wordChars; i < bf.BitLen; i++) // неполное последнее слово
+    buf[len++] = bf.GetBit(i) ? '1' : '0';
+  ostr.write(buf, len);
+  return ostr;
 }
+
+// явные инстанцирования для поддерживаемых типов слов
+
+#define BITFIELD_INSTANTIATE(TWord)                                           \
+  template class TBasicBitField<TWord>;                                       \
+  template istream &operator>>(istream &istr, TBasicBitField<TWord> &bf);     \
+  template ostream &operator<<(ostream &ostr, const TBasicBitField<TWord> &bf);
+
+BITFIELD_INSTANTIATE(unsigned int)
+BITFIELD_INSTANTIATE(unsigned long long)
+#ifdef __SIZEOF_INT128__
+BITFIELD_INSTANTIATE(unsigned __int128)
+#endif
@@ -0,0 +1,176 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tbitfieldview.cpp
+//
+// Представление диапазона битов битового поля без копирования
+
+#include "tbitfieldview.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+
+TBitFieldView::TBitFieldView(const TBitField &bf)
+  : pField(&bf), Lo(0), BitLen(bf.GetLength())
+{
+}
+
+TBitFieldView::TBitFieldView(const TBitField &bf, int lo, int hi)
+  : pField(&bf), Lo(lo), BitLen(hi - lo)
+{
+  if ((lo < 0) || (lo > hi) || (hi > bf.GetLength()))
+    throw out_of_range("bit range out of range");
+}
+
+TBitFieldView::TBitFieldView(const TBitFieldView &v, int lo, int hi)
+  : pField(v.pField), Lo(v.Lo + lo), BitLen(hi - lo)
+{
+  if ((lo < 0) || (lo > hi) || (hi > v.BitLen))
+    throw out_of_range("bit range out of range");
+}
+
+void TBitFieldView::Words(int first, int n, TELEM *dst) const // слова first..first+n-1
+{
+  int words = (BitLen + BitsInElem - 1) / BitsInElem;
+  int m = (first < words) ? ((n < words - first) ? n : words - first) : 0;
+  if (m > 0)
+  {
+    int start = Lo / BitsInElem + first;
+    TBitField::CopyBits(dst, m, pField->pMem + start, pField->MemLen - start, Lo % BitsInElem);
+    if ((first + m == words) && (BitLen % BitsInElem != 0)) // биты поля за концом диапазона
+      dst[m - 1] &= (TELEM(1) << (BitLen % BitsInElem)) - 1;
+  }
+  if (m < n)
+    BitZero(dst + m, n - m);
+}
+
+// доступ к битам
+
+int TBitFieldView::GetLength(void) const
+{
+  return BitLen;
+}
+
+int TBitFieldView::GetBit(const int n) const
+{
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  return pField->GetBit(Lo + n);
+}
+
+int TBitFieldView::Count(void) const
+{
+  return pField->CountRange(Lo, Lo + BitLen);
+}
+
+int TBitFieldView::FindFirst(void) const
+{
+  return FindNext(-1);
+}
+
+int TBitFieldView::FindLast(void) const
+{
+  return FindPrev(BitLen);
+}
+
+int TBitFieldView::FindNext(const int n) const // первый установленный после n
+{
+  if ((n < -1) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  // поиск в поле не должен уходить за пределы диапазона
+  if (!pField->AnyInRange(Lo + n + 1, Lo + BitLen))
+    return -1;
+  return pField->FindNext(Lo + n) - Lo;
+}
+
+int TBitFieldView::FindPrev(const int n) const // последний установленный до n
+{
+  if ((n < 0) || (n > BitLen))
+    throw out_of_range("bit index out of range");
+  if (!pField->AnyInRange(Lo, Lo + n))
+    return -1;
+  return pField->FindPrev(Lo + n) - Lo;
+}
+
+TBitField TBitFieldView::Extract(void) const // копия битов
+{
+  return pField->Extract(Lo, Lo + BitLen);
+}
+
+TBitViewIterator TBitFieldView::begin(void) const
+{
+  return TBitViewIterator(this, FindFirst());
+}
+
+TBitViewIterator TBitFieldView::end(void) const
+{
+  return TBitViewIterator(this, -1);
+}
+
+// битовые операции: слова представлений собираются блоками по BlockLen
+// слов, над блоками работают общие SIMD-ядра (tbitops.h)
+
+int TBitFieldView::operator==(const TBitFieldView &v) const // сравнение
+{
+  if (BitLen != v.BitLen)
+    return 0;
+  int words = (BitLen + BitsInElem - 1) / BitsInElem;
+  TELEM a[BlockLen], b[BlockLen];
+  for (int lo = 0; lo < words; lo += BlockLen)
+  {
+    int n = (words - lo < BlockLen) ? words - lo : BlockLen;
+    Words(lo, n, a);
+    v.Words(lo, n, b);
+    if (!BitEqual(a, b, n))
+      return 0;
+  }
+  return 1;
+}
+
+int TBitFieldView::operator!=(const TBitFieldView &v) const // сравнение
+{
+  return !(*this == v);
+}
+
+TBitField TBitFieldView::Combine(const TBitFieldView &a, const TBitFieldView &b, TWordOp op)
+{
+  TBitField res(0, a.pField->pRes);
+  res.Resize((a.BitLen > b.BitLen) ? a.BitLen : b.BitLen); // все слова записываются ниже
+  TELEM buf[BlockLen];
+  for (int lo = 0; lo < res.MemLen; lo += BlockLen)
+  {
+    int n = (res.MemLen - lo < BlockLen) ? res.MemLen - lo : BlockLen;
+    a.Words(lo, n, res.pMem + lo);
+    b.Words(lo, n, buf);
+    op(res.pMem + lo, res.pMem + lo, buf, n);
+  }
+  return res;
+}
+
+TBitField operator|(const TBitFieldView &a, const TBitFieldView &b) // "или"
+{
+  return TBitFieldView::Combine(a, b, BitOr<TELEM>);
+}
+
+TBitField operator&(const TBitFieldView &a, const TBitFieldView &b) // "и"
+{
+  return TBitFieldView::Combine(a, b, BitAnd<TELEM>);
+}
+
+TBitField operator^(const TBitFieldView &a, const TBitFieldView &b) // "исключающее или"
+{
+  return TBitFieldView::Combine(a, b, BitXor<TELEM>);
+}
+
+TBitField TBitFieldView::operator~(void) const // отрицание
+{
+  TBitField res(0, pField->pRes);
+  res.Resize(BitLen);
+  for (int lo = 0; lo < res.MemLen; lo += BlockLen)
+  {
+    int n = (res.MemLen - lo < BlockLen) ? res.MemLen - lo : BlockLen;
+    Words(lo, n, res.pMem + lo);
+    BitNot(res.pMem + lo, res.pMem + lo, n);
+  }
+  res.ClearTail();
+  return res;
+}
@@ -0,0 +1,708 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tbitops.cpp
+//
+// Ядра поразрядных операций над массивами слов
+
+#include "tbitops.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BITOPS_X86
+#include <immintrin.h>
+#endif
+
+typedef unsigned char TByte;
+typedef unsigned long long TChunk; // порция скалярной обработки
+
+typedef void (*TBinKernel)(void *dst, const void *a, const void *b, size_t bytes);
+typedef void (*TUnKernel)(void *dst, const void *a, size_t bytes);
+typedef long long (*TCountKernel)(const void *a, size_t bytes);
+
+struct TBitOpsTable // таблица ядер для одного набора инструкций
+{
+  TBinKernel Or;
+  TBinKernel And;
+  TBinKernel Xor;
+  TBinKernel AndNot;
+  TUnKernel  Not;
+  TCountKernel Count;
+};
+
+// скалярные ядра (используются также для хвостов векторных); память
+// читается порциями по 8 байтов через memcpy, поэтому тип слов
+// вызывающей стороны не важен
+
+#define SCALAR_BIN_KERNEL(name, expr)                                         \
+static void name(void *dst, const void *a, const void *b, size_t bytes)       \
+{                                                                             \
+  TByte *pd = (TByte *)dst;                                                   \
+  const TByte *pa = (const TByte *)a, *pb = (const TByte *)b;                 \
+  size_t i = 0;                                                               \
+  for (; i + sizeof(TChunk) <= bytes; i += sizeof(TChunk))                    \
+  {                                                                           \
+    TChunk x, y;                                                              \
+    memcpy(&x, pa + i, sizeof(x));                                            \
+    memcpy(&y, pb + i, sizeof(y));                                            \
+    x = expr;                                                                 \
+    memcpy(pd + i, &x, sizeof(x));                                            \
+  }                                                                           \
+  for (; i < bytes; i++)                                                      \
+  {                                                                           \
+    TByte x = pa[i], y = pb[i];                                               \
+    pd[i] = (TByte)(expr);                                                    \
+  }                                                                           \
+}
+
+SCALAR_BIN_KERNEL(OrScalar,     x | y)
+SCALAR_BIN_KERNEL(AndScalar,    x & y)
+SCALAR_BIN_KERNEL(XorScalar,    x ^ y)
+SCALAR_BIN_KERNEL(AndNotScalar, x & ~y)
+
+static void NotScalar(void *dst, const void *a, size_t bytes)
+{
+  TByte *pd = (TByte *)dst;
+  const TByte *pa = (const TByte *)a;
+  size_t i = 0;
+  for (; i + sizeof(TChunk) <= bytes; i += sizeof(TChunk))
+  {
+    TChunk x;
+    memcpy(&x, pa + i, sizeof(x));
+    x = ~x;
+    memcpy(pd + i, &x, sizeof(x));
+  }
+  for (; i < bytes; i++)
+    pd[i] = (TByte)~pa[i];
+}
+
+static long long CountScalar(const void *a, size_t bytes)
+{
+  const TByte *pa = (const TByte *)a;
+  long long res = 0;
+  size_t i = 0;
+  for (; i + sizeof(TChunk) <= bytes; i += sizeof(TChunk))
+  {
+    TChunk x;
+    memcpy(&x, pa + i, sizeof(x));
+    for (; x != 0; x &= x - 1)
+      res++;
+  }
+  for (; i < bytes; i++)
+    for (TByte x = pa[i]; x != 0; x &= x - 1)
+      res++;
+  return res;
+}
+
+static const TBitOpsTable ScalarTable =
+  { OrScalar, AndScalar, XorScalar, AndNotScalar, NotScalar, CountScalar };
+
+#ifdef BITOPS_X86
+
+// за одну итерацию обрабатывается строка кэша (64 байта) каждого операнда
+static const size_t LineBytes = 64;
+
+// SSE2: 4 регистра по 128 бит на строку
+
+#define SSE2_BIN_KERNEL(name, intr, tail)                                     \
+__attribute__((target("sse2")))                                               \
+static void name(void *dst, const void *a, const void *b, size_t bytes)       \
+{                                                                             \
+  TByte *pd = (TByte *)dst;                                                   \
+  const TByte *pa = (const TByte *)a, *pb = (const TByte *)b;                 \
+  size_t i = 0;                                                               \
+  for (; i + LineBytes <= bytes; i += LineBytes)                              \
+  {                                                                           \
+    const __m128i *va = (const __m128i *)(pa + i);                            \
+    const __m128i *vb = (const __m128i *)(pb + i);                            \
+    __m128i x0 = intr(_mm_loadu_si128(va + 0), _mm_loadu_si128(vb + 0));      \
+    __m128i x1 = intr(_mm_loadu_si128(va + 1), _mm_loadu_si128(vb + 1));      \
+    __m128i x2 = intr(_mm_loadu_si128(va + 2), _mm_loadu_si128(vb + 2));      \
+    __m128i x3 = intr(_mm_loadu_si128(va + 3), _mm_loadu_si128(vb + 3));      \
+    __m128i *vd = (__m128i *)(pd + i);                                        \
+    _mm_storeu_si128(vd + 0, x0);                                             \
+    _mm_storeu_si128(vd + 1, x1);                                             \
+    _mm_storeu_si128(vd + 2, x2);                                             \
+    _mm_storeu_si128(vd + 3, x3);                                             \
+  }                                                                           \
+  tail(pd + i, pa + i, pb + i, bytes - i);                                    \
+}
+
+SSE2_BIN_KERNEL(OrSse2,  _mm_or_si128,  OrScalar)
+SSE2_BIN_KERNEL(AndSse2, _mm_and_si128, AndScalar)
+SSE2_BIN_KERNEL(XorSse2, _mm_xor_si128, XorScalar)
+// _mm_andnot_si128(x, y) вычисляет ~x & y
+#define SSE2_ANDNOT(x, y) _mm_andnot_si128(y, x)
+SSE2_BIN_KERNEL(AndNotSse2, SSE2_ANDNOT, AndNotScalar)
+
+__attribute__((target("sse2")))
+static void NotSse2(void *dst, const void *a, size_t bytes)
+{
+  TByte *pd = (TByte *)dst;
+  const TByte *pa = (const TByte *)a;
+  const __m128i ones = _mm_set1_epi32(-1);
+  size_t i = 0;
+  for (; i + LineBytes <= bytes; i += LineBytes)
+  {
+    const __m128i *va = (const __m128i *)(pa + i);
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(va + 0), ones);
+    __m128i x1 = _mm_xor_si128(_mm_loadu_si128(va + 1), ones);
+    __m128i x2 = _mm_xor_si128(_mm_loadu_si128(va + 2), ones);
+    __m128i x3 = _mm_xor_si128(_mm_loadu_si128(va + 3), ones);
+    __m128i *vd = (__m128i *)(pd + i);
+    _mm_storeu_si128(vd + 0, x0);
+    _mm_storeu_si128(vd + 1, x1);
+    _mm_storeu_si128(vd + 2, x2);
+    _mm_storeu_si128(vd + 3, x3);
+  }
+  NotScalar(pd + i, pa + i, bytes - i);
+}
+
+// SSE2 не гарантирует наличия POPCNT, поэтому подсчет битов - скалярный
+static const TBitOpsTable Sse2Table =
+  { OrSse2, AndSse2, XorSse2, AndNotSse2, NotSse2, CountScalar };
+
+// AVX2: 2 регистра по 256 бит на строку
+
+#define AVX2_BIN_KERNEL(name, intr, tail)                                     \
+__attribute__((target("avx2")))                                               \
+static void name(void *dst, const void *a, const void *b, size_t bytes)       \
+{                                                                             \
+  TByte *pd = (TByte *)dst;                                                   \
+  const TByte *pa = (const TByte *)a, *pb = (const TByte *)b;                 \
+  size_t i = 0;                                                               \
+  for (; i + LineBytes <= bytes; i += LineBytes)                              \
+  {                                                                           \
+    const __m256i *va = (const __m256i *)(pa + i);                            \
+    const __m256i *vb = (const __m256i *)(pb + i);                            \
+    __m256i x0 = intr(_mm256_loadu_si256(va + 0), _mm256_loadu_si256(vb + 0)); \
+    __m256i x1 = intr(_mm256_loadu_si256(va + 1), _mm256_loadu_si256(vb + 1)); \
+    __m256i *vd = (__m256i *)(pd + i);                                        \
+    _mm256_storeu_si256(vd + 0, x0);                                          \
+    _mm256_storeu_si256(vd + 1, x1);                                          \
+  }                                                                           \
+  tail(pd + i, pa + i, pb + i, bytes - i);                                    \
+}
+
+AVX2_BIN_KERNEL(OrAvx2,  _mm256_or_si256,  OrScalar)
+AVX2_BIN_KERNEL(AndAvx2, _mm256_and_si256, AndScalar)
+AVX2_BIN_KERNEL(XorAvx2, _mm256_xor_si256, XorScalar)
+#define AVX2_ANDNOT(x, y) _mm256_andnot_si256(y, x)
+AVX2_BIN_KERNEL(AndNotAvx2, AVX2_ANDNOT, AndNotScalar)
+
+__attribute__((target("avx2")))
+static void NotAvx2(void *dst, const void *a, size_t bytes)
+{
+  TByte *pd = (TByte *)dst;
+  const TByte *pa = (const TByte *)a;
+  const __m256i ones = _mm256_set1_epi32(-1);
+  size_t i = 0;
+  for (; i + LineBytes <= bytes; i += LineBytes)
+  {
+    const __m256i *va = (const __m256i *)(pa + i);
+    __m256i x0 = _mm256_xor_si256(_mm256_loadu_si256(va + 0), ones);
+    __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256(va + 1), ones);
+    __m256i *vd = (__m256i *)(pd + i);
+    _mm256_storeu_si256(vd + 0, x0);
+    _mm256_storeu_si256(vd + 1, x1);
+  }
+  NotScalar(pd + i, pa + i, bytes - i);
+}
+
+// подсчет битов: аппаратный POPCNT для коротких массивов и хвостов,
+// для длинных - алгоритм Харли-Сила на регистрах AVX2 (Mula, Kurz, Lemire):
+// сумматоры с сохранением переноса сводят 16 векторов к одному вызову
+// векторного popcount (по таблице полубайтов)
+
+__attribute__((target("popcnt")))
+static long long CountPopcnt(const void *a, size_t bytes)
+{
+  const TByte *pa = (const TByte *)a;
+  long long res = 0;
+  size_t i = 0;
+  for (; i + sizeof(TChunk) <= bytes; i += sizeof(TChunk))
+  {
+    TChunk x;
+    memcpy(&x, pa + i, sizeof(x));
+    res += __builtin_popcountll(x);
+  }
+  for (; i < bytes; i++)
+    res += __builtin_popcount(pa[i]);
+  return res;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i Popcount256(__m256i v)
+{
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                          1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3,
+                                          1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low = _mm256_set1_epi8(0x0f);
+  __m256i lo = _mm256_and_si256(v, low);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+  __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                _mm256_shuffle_epi8(lookup, hi));
+  return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+// сумматор с сохранением переноса: h:l = a + b + c
+#define CSA256(h, l, a, b, c)                                                 \
+  {                                                                           \
+    __m256i u = _mm256_xor_si256(a, b);                                       \
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));     \
+    l = _mm256_xor_si256(u, c);                                               \
+  }
+
+__attribute__((target("avx2,popcnt")))
+static long long CountAvx2(const void *a, size_t bytes)
+{
+  const size_t blockBytes = 16 * 32; // 16 векторов по 32 байта
+  const __m256i *d = (const __m256i *)a;
+  __m256i total = _mm256_setzero_si256();
+  __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones;
+  __m256i sixteens, twosA, twosB, foursA, foursB, eightsA, eightsB;
+  size_t blocks = bytes / blockBytes;
+  for (size_t k = 0; k < blocks; k++, d += 16)
+  {
+    CSA256(twosA, ones, ones, _mm256_loadu_si256(d + 0), _mm256_loadu_si256(d + 1));
+    CSA256(twosB, ones, ones, _mm256_loadu_si256(d + 2), _mm256_loadu_si256(d + 3));
+    CSA256(foursA, twos, twos, twosA, twosB);
+    CSA256(twosA, ones, ones, _mm256_loadu_si256(d + 4), _mm256_loadu_si256(d + 5));
+    CSA256(twosB, ones, ones, _mm256_loadu_si256(d + 6), _mm256_loadu_si256(d + 7));
+    CSA256(foursB, twos, twos, twosA, twosB);
+    CSA256(eightsA, fours, fours, foursA, foursB);
+    CSA256(twosA, ones, ones, _mm256_loadu_si256(d + 8), _mm256_loadu_si256(d + 9));
+    CSA256(twosB, ones, ones, _mm256_loadu_si256(d + 10), _mm256_loadu_si256(d + 11));
+    CSA256(foursA, twos, twos, twosA, twosB);
+    CSA256(twosA, ones, ones, _mm256_loadu_si256(d + 12), _mm256_loadu_si256(d + 13));
+    CSA256(twosB, ones, ones, _mm256_loadu_si256(d + 14), _mm256_loadu_si256(d + 15));
+    CSA256(foursB, twos, twos, twosA, twosB);
+    CSA256(eightsB, fours, fours, foursA, foursB);
+    CSA256(sixteens, eights, eights, eightsA, eightsB);
+    total = _mm256_add_epi64(total, Popcount256(sixteens));
+  }
+  total = _mm256_slli_epi64(total, 4);
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(Popcount256(eights), 3));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(Popcount256(fours), 2));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(Popcount256(twos), 1));
+  total = _mm256_add_epi64(total, Popcount256(ones));
+  long long lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, total);
+  long long res = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  size_t done = blocks * blockBytes;
+  return res + CountPopcnt((const TByte *)a + done, bytes - done);
+}
+
+static const TBitOpsTable Avx2Table =
+  { OrAvx2, AndAvx2, XorAvx2, AndNotAvx2, NotAvx2, CountAvx2 };
+
+// AVX-512: 1 регистр на строку
+
+#define AVX512_BIN_KERNEL(name, intr, tail)                                   \
+__attribute__((target("avx512f")))                                            \
+static void name(void *dst, const void *a, const void *b, size_t bytes)       \
+{                                                                             \
+  TByte *pd = (TByte *)dst;                                                   \
+  const TByte *pa = (const TByte *)a, *pb = (const TByte *)b;                 \
+  size_t i = 0;                                                               \
+  for (; i + LineBytes <= bytes; i += LineBytes)                              \
+    _mm512_storeu_si512(pd + i, intr(_mm512_loadu_si512(pa + i),             \
+                                     _mm512_loadu_si512(pb + i)));           \
+  tail(pd + i, pa + i, pb + i, bytes - i);                                    \
+}
+
+AVX512_BIN_KERNEL(OrAvx512,  _mm512_or_si512,  OrScalar)
+AVX512_BIN_KERNEL(AndAvx512, _mm512_and_si512, AndScalar)
+AVX512_BIN_KERNEL(XorAvx512, _mm512_xor_si512, XorScalar)
+#define AVX512_ANDNOT(x, y) _mm512_andnot_si512(y, x)
+AVX512_BIN_KERNEL(AndNotAvx512, AVX512_ANDNOT, AndNotScalar)
+
+__attribute__((target("avx512f")))
+static void NotAvx512(void *dst, const void *a, size_t bytes)
+{
+  TByte *pd = (TByte *)dst;
+  const TByte *pa = (const TByte *)a;
+  const __m512i ones = _mm512_set1_epi32(-1);
+  size_t i = 0;
+  for (; i + LineBytes <= bytes; i += LineBytes)
+    _mm512_storeu_si512(pd + i, _mm512_xor_si512(_mm512_loadu_si512(pa + i), ones));
+  NotScalar(pd + i, pa + i, bytes - i);
+}
+
+// подсчет битов для AVX-512 - вариант AVX2 (VPOPCNTDQ есть не везде)
+static const TBitOpsTable Avx512Table =
+  { OrAvx512, AndAvx512, XorAvx512, AndNotAvx512, NotAvx512, CountAvx2 };
+
+#endif // BITOPS_X86
+
+// выбор ядер
+
+static int IsaSupported(TBitOpsIsa isa)
+{
+#ifdef BITOPS_X86
+  __builtin_cpu_init();
+  switch (isa)
+  {
+    case BITOPS_SCALAR: return 1;
+    case BITOPS_SSE2:   return __builtin_cpu_supports("sse2");
+    case BITOPS_AVX2:   return __builtin_cpu_supports("avx2") &&
+                               __builtin_cpu_supports("popcnt");
+    case BITOPS_AVX512: return __builtin_cpu_supports("avx512f") &&
+                               __builtin_cpu_supports("avx2") &&
+                               __builtin_cpu_supports("popcnt");
+  }
+  return 0;
+#else
+  return isa == BITOPS_SCALAR;
+#endif
+}
+
+static const TBitOpsTable *IsaTable(TBitOpsIsa isa)
+{
+#ifdef BITOPS_X86
+  switch (isa)
+  {
+    case BITOPS_SSE2:   return &Sse2Table;
+    case BITOPS_AVX2:   return &Avx2Table;
+    case BITOPS_AVX512: return &Avx512Table;
+    default:            break;
+  }
+#endif
+  return &ScalarTable;
+}
+
+static TBitOpsIsa DetectIsa(void)
+{
+  if (IsaSupported(BITOPS_AVX512))
+    return BITOPS_AVX512;
+  if (IsaSupported(BITOPS_AVX2))
+    return BITOPS_AVX2;
+  if (IsaSupported(BITOPS_SSE2))
+    return BITOPS_SSE2;
+  return BITOPS_SCALAR;
+}
+
+static int DefaultThreads(void)
+{
+  int n = (int)thread::hardware_concurrency();
+  return (n > 0) ? n : 1;
+}
+
+// выбранный набор инструкций и его ядра, настройки пула; все поля меняются
+// атомарно, пока другие потоки выполняют операции
+struct TBitOpsState
+{
+  atomic<TBitOpsIsa> Isa;
+  atomic<const TBitOpsTable *> Table;
+  atomic<int> Threads;          // к-во частей параллельного выполнения
+  atomic<size_t> ParallelBytes; // порог параллельного выполнения
+
+  TBitOpsState(TBitOpsIsa isa)
+    : Isa(isa), Table(IsaTable(isa)), Threads(DefaultThreads()), ParallelBytes(size_t(4) << 20) {}
+};
+
+// определяется при первом обращении, чтобы не зависеть от порядка
+// инициализации статических объектов в разных единицах трансляции;
+// все поля заполняются в потокобезопасной инициализации статического объекта
+static TBitOpsState &State(void)
+{
+  static TBitOpsState state(DetectIsa());
+  return state;
+}
+
+static const TBitOpsTable *Table(void) // ядра выбранного набора инструкций
+{
+  return State().Table.load(memory_order_relaxed);
+}
+
+TBitOpsIsa BitOpsGetIsa(void)
+{
+  return State().Isa;
+}
+
+int BitOpsSetIsa(TBitOpsIsa isa)
+{
+  if (!IsaSupported(isa))
+    return 0;
+  State().Table = IsaTable(isa);
+  State().Isa = isa;
+  return 1;
+}
+
+const char *BitOpsIsaName(TBitOpsIsa isa)
+{
+  switch (isa)
+  {
+    case BITOPS_SCALAR: return "scalar";
+    case BITOPS_SSE2:   return "sse2";
+    case BITOPS_AVX2:   return "avx2";
+    case BITOPS_AVX512: return "avx512";
+  }
+  return "unknown";
+}
+
+// параллельное выполнение
+
+static const size_t PartAlign = 64; // границы частей - по строкам кэша
+static const int MaxThreads = 256;
+
+int BitOpsGetThreads(void)
+{
+  return State().Threads.load(memory_order_relaxed);
+}
+
+void BitOpsSetThreads(int n)
+{
+  if (n <= 0)
+    n = DefaultThreads();
+  State().Threads.store((n < MaxThreads) ? n : MaxThreads, memory_order_relaxed);
+}
+
+size_t BitOpsGetParallelBytes(void)
+{
+  return State().ParallelBytes.load(memory_order_relaxed);
+}
+
+void BitOpsSetParallelBytes(size_t bytes)
+{
+  State().ParallelBytes.store(bytes, memory_order_relaxed);
+}
+
+static size_t PartBegin(size_t bytes, int parts, int k) // начало части k
+{
+  if (k >= parts)
+    return bytes;
+  size_t b = bytes / parts * k;
+  return b - b % PartAlign;
+}
+
+// потоки, выполняющие части одного задания; часть 0 выполняет вызвавший
+// поток, часть k > 0 - всегда поток Workers[k - 1]
+class TBitPool
+{
+private:
+  vector<thread> Workers;
+  mutex Busy;                     // задание выполняется одно за раз
+  mutex Lock;                     // защищает поля задания
+  condition_variable Start, Done;
+  TBitTask Task;
+  void *Ctx;
+  size_t Bytes;
+  int Parts;                      // к-во частей задания
+  int Pending;                    // к-во невыполненных частей потоков пула
+  unsigned Gen;                   // номер задания
+  bool Stop;
+
+  void Work(int k, unsigned gen)
+  {
+    unique_lock<mutex> lk(Lock);
+    for (;;)
+    {
+      Start.wait(lk, [&] { return Stop || (Gen != gen); });
+      if (Stop)
+        return;
+      gen = Gen;
+      if (k >= Parts)
+        continue;
+      TBitTask task = Task;
+      void *ctx = Ctx;
+      size_t lo = PartBegin(Bytes, Parts, k), hi = PartBegin(Bytes, Parts, k + 1);
+      lk.unlock();
+      task(lo, hi, ctx);
+      lk.lock();
+      if (--Pending == 0)
+        Done.notify_one();
+    }
+  }
+public:
+  TBitPool() : Task(0), Ctx(0), Bytes(0), Parts(0), Pending(0), Gen(0), Stop(false) {}
+
+  ~TBitPool()
+  {
+    {
+      lock_guard<mutex> lk(Lock);
+      Stop = true;
+    }
+    Start.notify_all();
+    for (size_t k = 0; k < Workers.size(); k++)
+      Workers[k].join();
+  }
+
+  // выполнить задание из parts частей; 0, если пул занят другим заданием
+  // (в том числе при вызове из части текущего задания)
+  int Run(size_t bytes, int parts, TBitTask task, void *ctx)
+  {
+    unique_lock<mutex> busy(Busy, try_to_lock);
+    if (!busy.owns_lock())
+      return 0;
+    while ((int)Workers.size() < parts - 1)
+      Workers.push_back(thread(&TBitPool::Work, this, (int)Workers.size() + 1, Gen));
+    {
+      lock_guard<mutex> lk(Lock);
+      Task = task;
+      Ctx = ctx;
+      Bytes = bytes;
+      Parts = parts;
+      Pending = parts - 1;
+      Gen++;
+    }
+    Start.notify_all();
+    task(0, PartBegin(bytes, parts, 1), ctx);
+    unique_lock<mutex> lk(Lock);
+    Done.wait(lk, [&] { return Pending == 0; });
+    return 1;
+  }
+};
+
+static TBitPool &Pool(void)
+{
+  static TBitPool pool;
+  return pool;
+}
+
+void BitParallelFor(size_t bytes, TBitTask task, void *ctx)
+{
+  int parts = BitOpsGetThreads();
+  if ((parts > 1) && (bytes / PartAlign < (size_t)parts))
+    parts = (int)(bytes / PartAlign);
+  if ((parts < 2) || (bytes < BitOpsGetParallelBytes()) || !Pool().Run(bytes, parts, task, ctx))
+    task(0, bytes, ctx);
+}
+
+// части операций
+
+struct TBinArgs
+{
+  TBinKernel Kernel;
+  TByte *Dst;
+  const TByte *A, *B;
+};
+
+static void BinPart(size_t lo, size_t hi, void *ctx)
+{
+  TBinArgs *p = (TBinArgs *)ctx;
+  p->Kernel(p->Dst + lo, p->A + lo, p->B + lo, hi - lo);
+}
+
+static void RunBin(TBinKernel kernel, void *dst, const void *a, const void *b, size_t bytes)
+{
+  TBinArgs args = { kernel, (TByte *)dst, (const TByte *)a, (const TByte *)b };
+  BitParallelFor(bytes, BinPart, &args);
+}
+
+struct TUnArgs
+{
+  TUnKernel Kernel;
+  TByte *Dst;
+  const TByte *A;
+};
+
+static void UnPart(size_t lo, size_t hi, void *ctx)
+{
+  TUnArgs *p = (TUnArgs *)ctx;
+  p->Kernel(p->Dst + lo, p->A + lo, hi - lo);
+}
+
+struct TCountArgs
+{
+  TCountKernel Kernel;
+  const TByte *A;
+  atomic<long long> Sum;
+};
+
+static void CountPart(size_t lo, size_t hi, void *ctx)
+{
+  TCountArgs *p = (TCountArgs *)ctx;
+  p->Sum += p->Kernel(p->A + lo, hi - lo);
+}
+
+static void ZeroPart(size_t lo, size_t hi, void *ctx)
+{
+  memset((TByte *)ctx + lo, 0, hi - lo);
+}
+
+static void CopyPart(size_t lo, size_t hi, void *ctx)
+{
+  TUnArgs *p = (TUnArgs *)ctx;
+  memcpy(p->Dst + lo, p->A + lo, hi - lo);
+}
+
+struct TEqualArgs
+{
+  const TByte *A, *B;
+  atomic<int> Equal;
+};
+
+static void EqualPart(size_t lo, size_t hi, void *ctx)
+{
+  TEqualArgs *p = (TEqualArgs *)ctx;
+  if (p->Equal && (memcmp(p->A + lo, p->B + lo, hi - lo) != 0))
+    p->Equal = 0;
+}
+
+// точки входа
+
+void BitOrBytes(void *dst, const void *a, const void *b, size_t bytes)
+{
+  RunBin(Table()->Or, dst, a, b, bytes);
+}
+
+void BitAndBytes(void *dst, const void *a, const void *b, size_t bytes)
+{
+  RunBin(Table()->And, dst, a, b, bytes);
+}
+
+void BitXorBytes(void *dst, const void *a, const void *b, size_t bytes)
+{
+  RunBin(Table()->Xor, dst, a, b, bytes);
+}
+
+void BitAndNotBytes(void *dst, const void *a, const void *b, size_t bytes)
+{
+  RunBin(Table()->AndNot, dst, a, b, bytes);
+}
+
+void BitNotBytes(void *dst, const void *a, size_t bytes)
+{
+  TUnArgs args = { Table()->Not, (TByte *)dst, (const TByte *)a };
+  BitParallelFor(bytes, UnPart, &args);
+}
+
+long long BitCountBytes(const void *a, size_t bytes)
+{
+  TCountArgs args;
+  args.Kernel = Table()->Count;
+  args.A = (const TByte *)a;
+  args.Sum = 0;
+  BitParallelFor(bytes, CountPart, &args);
+  return args.Sum;
+}
+
+void BitZeroBytes(void *dst, size_t bytes)
+{
+  BitParallelFor(bytes, ZeroPart, dst);
+}
+
+void BitCopyBytes(void *dst, const void *a, size_t bytes)
+{
+  TUnArgs args = { 0, (TByte *)dst, (const TByte *)a };
+  BitParallelFor(bytes, CopyPart, &args);
+}
+
+int BitEqualBytes(const void *a, const void *b, size_t bytes)
+{
+  TEqualArgs args;
+  args.A = (const TByte *)a;
+  args.B = (const TByte *)b;
+  args.Equal = 1;
+  BitParallelFor(bytes, EqualPart, &args);
+  return args.Equal;
+}
@@ -0,0 +1,97 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tconcurrentbitfield.cpp
+//
+// Битовое поле с атомарным доступом к битам из нескольких потоков
+
+#include "tconcurrentbitfield.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+
+TConcurrentBitField::TConcurrentBitField(int len)
+  : BitLen(len), Mem((len < 0) ? 0 : (len + BitsInElem - 1) / BitsInElem)
+{
+  if (len < 0)
+    throw invalid_argument("negative bitfield length");
+}
+
+TConcurrentBitField::TConcurrentBitField(const TBitField &bf)
+  : BitLen(bf.BitLen), Mem(bf.MemLen)
+{
+  for (int i = 0; i < bf.MemLen; i++)
+    Mem[i].store(bf.pMem[i], memory_order_relaxed);
+}
+
+int TConcurrentBitField::GetMemIndex(const int n) const // индекс Mem для бита n
+{
+  return n / BitsInElem;
+}
+
+TELEM TConcurrentBitField::GetMemMask(const int n) const // битовая маска для бита n
+{
+  return TELEM(1) << (n % BitsInElem);
+}
+
+void TConcurrentBitField::CheckIndex(const int n) const
+{
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+}
+
+int TConcurrentBitField::GetLength(void) const // получить длину (к-во битов)
+{
+  return BitLen;
+}
+
+void TConcurrentBitField::SetBit(const int n) // установить бит
+{
+  TestAndSet(n);
+}
+
+void TConcurrentBitField::ClrBit(const int n) // очистить бит
+{
+  TestAndClear(n);
+}
+
+int TConcurrentBitField::TestAndSet(const int n) // установить бит
+{
+  CheckIndex(n);
+  TELEM m = GetMemMask(n);
+  // без записи, если бит уже установлен: повторные попытки не захватывают
+  // строку кэша в исключительное владение
+  if (Mem[GetMemIndex(n)].load(memory_order_acquire) & m)
+    return 1;
+  return (Mem[GetMemIndex(n)].fetch_or(m, memory_order_acq_rel) & m) != 0;
+}
+
+int TConcurrentBitField::TestAndClear(const int n) // очистить бит
+{
+  CheckIndex(n);
+  TELEM m = GetMemMask(n);
+  if (!(Mem[GetMemIndex(n)].load(memory_order_acquire) & m))
+    return 0;
+  return (Mem[GetMemIndex(n)].fetch_and(~m, memory_order_acq_rel) & m) != 0;
+}
+
+int TConcurrentBitField::GetBit(const int n) const // получить значение бита
+{
+  CheckIndex(n);
+  return (Mem[GetMemIndex(n)].load(memory_order_acquire) & GetMemMask(n)) != 0;
+}
+
+int TConcurrentBitField::Count(void) const // к-во установленных битов
+{
+  int res = 0;
+  for (size_t i = 0; i < Mem.size(); i++)
+    res += BitPopcount(Mem[i].load(memory_order_relaxed));
+  return res;
+}
+
+TBitField TConcurrentBitField::Snapshot(void) const // копия в обычное поле
+{
+  TBitField res(BitLen);
+  for (int i = 0; i < res.MemLen; i++)
+    res.pMem[i] = Mem[i].load(memory_order_relaxed);
+  return res;
+}
@@ -0,0 +1,341 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tewahbitfield.cpp
+//
+// Битовое поле, сжатое кодированием серий (EWAH)
+
+#include "tewahbitfield.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+
+static const int BitsInWord = sizeof(TEWORD) * 8;
+static const TEWORD AllOnes = ~TEWORD(0);
+static const long long MaxRun  = 0xffffffffll; // наибольшая длина серии
+static const long long MaxLits = 0x7fffffffll; // наибольшее к-во литералов
+
+static int       RunBit(TEWORD m) { return (int)(m & 1); }
+static long long RunLen(TEWORD m) { return (long long)((m >> 1) & 0xffffffffull); }
+static long long LitCnt(TEWORD m) { return (long long)(m >> 33); }
+
+// запись последовательности слов в сжатом виде; одинаковые последовательности
+// слов всегда дают одинаковый Buffer, поэтому поля можно сравнивать побуферно
+class TEwahWriter
+{
+private:
+  vector<TEWORD> &Buf;
+  long long Marker; // индекс текущего маркера в Buf (-1 - нет)
+
+  void NewMarker(void)
+  {
+    Buf.push_back(0);
+    Marker = (long long)Buf.size() - 1;
+  }
+public:
+  long long Words;  // к-во записанных слов
+
+  TEwahWriter(vector<TEWORD> &buf) : Buf(buf), Marker(-1), Words(0) {}
+
+  void AddClean(int bit, long long n) // n слов, все биты которых равны bit
+  {
+    Words += n;
+    while (n > 0)
+    {
+      TEWORD m = (Marker >= 0) ? Buf[Marker] : 0;
+      long long len = RunLen(m);
+      if ((Marker >= 0) && (LitCnt(m) == 0) && ((len == 0) || (RunBit(m) == bit)) &&
+          (len < MaxRun))
+      {
+        long long k = (n < MaxRun - len) ? n : MaxRun - len;
+        Buf[Marker] = TEWORD(bit) | (TEWORD(len + k) << 1);
+        n -= k;
+      }
+      else
+        NewMarker();
+    }
+  }
+
+  void AddLiteral(TEWORD w) // слово со смешанными битами
+  {
+    Words++;
+    if ((Marker < 0) || (LitCnt(Buf[Marker]) == MaxLits))
+      NewMarker();
+    Buf[Marker] += TEWORD(1) << 33;
+    Buf.push_back(w);
+  }
+
+  void AddWord(TEWORD w) // произвольное слово
+  {
+    if (w == 0)
+      AddClean(0, 1);
+    else if (w == AllOnes)
+      AddClean(1, 1);
+    else
+      AddLiteral(w);
+  }
+};
+
+// последовательное чтение слов сжатого представления
+class TEwahReader
+{
+private:
+  const vector<TEWORD> &Buf;
+  size_t Pos;       // индекс следующего маркера
+public:
+  long long Run;    // осталось слов в текущей серии
+  int Bit;          // значение битов серии
+  long long Lits;   // осталось литералов после серии
+  size_t LitPos;    // индекс текущего литерала
+
+  TEwahReader(const vector<TEWORD> &buf)
+    : Buf(buf), Pos(0), Run(0), Bit(0), Lits(0), LitPos(0)
+  {
+    Load();
+  }
+
+  void Load(void) // перейти к следующему маркеру, если текущий исчерпан
+  {
+    while ((Run == 0) && (Lits == 0) && (Pos < Buf.size()))
+    {
+      TEWORD m = Buf[Pos];
+      Bit = RunBit(m);
+      Run = RunLen(m);
+      Lits = LitCnt(m);
+      LitPos = Pos + 1;
+      Pos += 1 + Lits;
+    }
+  }
+
+  int Done(void) const { return (Run == 0) && (Lits == 0); }
+
+  TEWORD Peek(void) const // текущее слово
+  {
+    return (Run > 0) ? (Bit ? AllOnes : 0) : Buf[LitPos];
+  }
+
+  void Skip(long long n) // пропустить n слов
+  {
+    while ((n > 0) && !Done())
+    {
+      long long k;
+      if (Run > 0)
+      {
+        k = (Run < n) ? Run : n;
+        Run -= k;
+      }
+      else
+      {
+        k = (Lits < n) ? Lits : n;
+        LitPos += k;
+        Lits -= k;
+      }
+      n -= k;
+      Load();
+    }
+  }
+
+  // переписать до n слов (с инверсией при neg) и вернуть их к-во
+  long long Copy(long long n, TEwahWriter &w, int neg)
+  {
+    long long done = 0;
+    while ((done < n) && !Done())
+    {
+      long long k;
+      if (Run > 0)
+      {
+        k = (Run < n - done) ? Run : n - done;
+        w.AddClean(Bit ^ neg, k);
+        Run -= k;
+      }
+      else
+      {
+        k = (Lits < n - done) ? Lits : n - done;
+        for (long long i = 0; i < k; i++)
+          w.AddLiteral(neg ? ~Buf[LitPos + i] : Buf[LitPos + i]);
+        LitPos += k;
+        Lits -= k;
+      }
+      done += k;
+      Load();
+    }
+    return done;
+  }
+};
+
+static long long WordCount(int len) // к-во слов для len битов
+{
+  return ((long long)len + BitsInWord - 1) / BitsInWord;
+}
+
+// поток "или"/"и" над сжатыми операндами
+static void Merge(const vector<TEWORD> &a, const vector<TEWORD> &b, int isAnd,
+                  long long nw, vector<TEWORD> &out)
+{
+  TEwahWriter w(out);
+  TEwahReader x(a), y(b);
+  const int absorb = isAnd ? 0 : 1; // серия, определяющая результат сама
+  while (!x.Done() && !y.Done())
+  {
+    if ((x.Run > 0) || (y.Run > 0))
+    {
+      TEwahReader &pred = (x.Run >= y.Run) ? x : y;
+      TEwahReader &prey = (x.Run >= y.Run) ? y : x;
+      long long k = pred.Run;
+      if (pred.Bit == absorb)
+      {
+        w.AddClean(absorb, k);
+        prey.Skip(k);
+      }
+      else // результат совпадает с другим операндом
+        w.AddClean(0, k - prey.Copy(k, w, 0));
+      pred.Skip(k);
+    }
+    else
+    {
+      long long k = (x.Lits < y.Lits) ? x.Lits : y.Lits;
+      for (long long i = 0; i < k; i++)
+      {
+        TEWORD u = a[x.LitPos + i], v = b[y.LitPos + i];
+        w.AddWord(isAnd ? (u & v) : (u | v));
+      }
+      x.Skip(k);
+      y.Skip(k);
+    }
+  }
+  // хвост более длинного операнда
+  if (!isAnd)
+    (x.Done() ? y : x).Copy(nw - w.Words, w, 0);
+  w.AddClean(0, nw - w.Words);
+}
+
+TEwahBitField::TEwahBitField(int len)
+{
+  if (len < 0)
+    throw invalid_argument("negative bitfield length");
+  BitLen = len;
+  TEwahWriter w(Buffer);
+  w.AddClean(0, WordCount(len));
+}
+
+TEwahBitField::TEwahBitField(const TBitField &bf) // сжатие
+{
+  BitLen = bf.BitLen;
+  TEwahWriter w(Buffer);
+  for (int i = 0; i < bf.MemLen; i += 2)
+  {
+    TEWORD x = bf.pMem[i];
+    if (i + 1 < bf.MemLen)
+      x |= TEWORD(bf.pMem[i + 1]) << 32;
+    w.AddWord(x);
+  }
+}
+
+TEwahBitField::operator TBitField() const // распаковка
+{
+  TBitField res(BitLen);
+  TEwahReader r(Buffer);
+  for (long long i = 0; !r.Done(); i++)
+  {
+    if ((r.Run > 0) && (r.Bit == 0)) // нулевые серии уже на месте
+    {
+      i += r.Run - 1;
+      r.Skip(r.Run);
+      continue;
+    }
+    TEWORD x = r.Peek();
+    res.pMem[2 * i] = TELEM(x);
+    if (2 * i + 1 < res.MemLen)
+      res.pMem[2 * i + 1] = TELEM(x >> 32);
+    r.Skip(1);
+  }
+  return res;
+}
+
+int TEwahBitField::GetLength(void) const // получить длину (к-во битов)
+{
+  return BitLen;
+}
+
+int TEwahBitField::GetBit(const int n) const // получить значение бита
+{
+  if ((n < 0) || (n >= BitLen))
+    throw out_of_range("bit index out of range");
+  long long word = n / BitsInWord, pos = 0;
+  size_t i = 0;
+  while (i < Buffer.size())
+  {
+    TEWORD m = Buffer[i];
+    long long run = RunLen(m), lits = LitCnt(m);
+    if (word < pos + run)
+      return RunBit(m);
+    if (word < pos + run + lits)
+      return (int)((Buffer[i + 1 + (word - pos - run)] >> (n % BitsInWord)) & 1);
+    pos += run + lits;
+    i += 1 + lits;
+  }
+  return 0;
+}
+
+int TEwahBitField::Count(void) const // к-во установленных битов
+{
+  long long res = 0;
+  size_t i = 0;
+  while (i < Buffer.size())
+  {
+    TEWORD m = Buffer[i];
+    long long lits = LitCnt(m);
+    if (RunBit(m))
+      res += RunLen(m) * BitsInWord;
+    for (long long k = 1; k <= lits; k++)
+      res += BitPopcount(Buffer[i + k]);
+    i += 1 + lits;
+  }
+  return (int)res;
+}
+
+int TEwahBitField::SizeInWords(void) const // размер сжатого представления
+{
+  return (int)Buffer.size();
+}
+
+int TEwahBitField::operator==(const TEwahBitField &bf) const // сравнение
+{
+  return (BitLen == bf.BitLen) && (Buffer == bf.Buffer);
+}
+
+int TEwahBitField::operator!=(const TEwahBitField &bf) const // сравнение
+{
+  return !(*this == bf);
+}
+
+TEwahBitField TEwahBitField::operator|(const TEwahBitField &bf) const // "или"
+{
+  TEwahBitField res(0);
+  res.BitLen = (BitLen > bf.BitLen) ? BitLen : bf.BitLen;
+  Merge(Buffer, bf.Buffer, 0, WordCount(res.BitLen), res.Buffer);
+  return res;
+}
+
+TEwahBitField TEwahBitField::operator&(const TEwahBitField &bf) const // "и"
+{
+  TEwahBitField res(0);
+  res.BitLen = (BitLen > bf.BitLen) ? BitLen : bf.BitLen;
+  Merge(Buffer, bf.Buffer, 1, WordCount(res.BitLen), res.Buffer);
+  return res;
+}
+
+TEwahBitField TEwahBitField::operator~(void) const // отрицание
+{
+  TEwahBitField res(0);
+  res.BitLen = BitLen;
+  TEwahWriter w(res.Buffer);
+  TEwahReader r(Buffer);
+  long long nw = WordCount(BitLen);
+  int tail = BitLen % BitsInWord;
+  // последнее неполное слово инвертируется с маской, чтобы биты за
+  // пределами BitLen остались нулевыми
+  r.Copy(tail ? nw - 1 : nw, w, 1);
+  if (tail)
+    w.AddWord(~r.Peek() & ((TEWORD(1) << tail) - 1));
+  return res;
+}
@@ -0,0 +1,193 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tmappedbitfield.cpp
+//
+// Битовое поле, отображенное в память из файла двоичного формата
+
+#include "tmappedbitfield.h"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BITFIELD_MMAP
+#endif
+
+TMappedBitField::TMappedBitField(const char *name, TMode mode, int verify)
+  : Field(0), pMap(0), MapSize(0), Mode(mode)
+{
+#if defined(BITFIELD_MMAP) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  int fd = open(name, O_RDONLY);
+  if (fd < 0)
+    throw runtime_error(string("cannot open ") + name);
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    throw runtime_error(string("cannot stat ") + name);
+  }
+  size_t size = (size_t)st.st_size;
+  if (size < TBitField::SavedHeaderSize)
+  {
+    close(fd);
+    throw runtime_error("truncated binary bitfield");
+  }
+  // последнее слово поля может выходить за конец файла: место резервируется
+  // до границы страницы после него, за концом файла - нулевые страницы
+  int prot = (mode == CopyOnWrite) ? PROT_READ | PROT_WRITE : PROT_READ;
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  MapSize = (size + sizeof(TELEM) + page - 1) / page * page;
+  void *p = mmap(0, MapSize, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p != MAP_FAILED)
+  {
+    int flags = ((mode == CopyOnWrite) ? MAP_PRIVATE : MAP_SHARED) | MAP_FIXED;
+    if (mmap(p, size, prot, flags, fd, 0) == MAP_FAILED)
+    {
+      munmap(p, MapSize);
+      p = MAP_FAILED;
+    }
+  }
+  close(fd);
+  if (p == MAP_FAILED)
+    throw runtime_error(string("cannot map ") + name);
+  pMap = p;
+
+  try
+  {
+    int len = TBitField::SavedLength(pMap, size, verify);
+    // байты за концом записи стали бы частью последнего слова поля
+    if (size != TBitField::SavedHeaderSize + ((size_t)len + 7) / 8)
+      throw runtime_error("trailing data after binary bitfield");
+    TELEM *mem = (TELEM *)((char *)pMap + TBitField::SavedHeaderSize);
+    int memLen = (len + sizeof(TELEM) * 8 - 1) / (sizeof(TELEM) * 8);
+    // запросы полагаются на нулевые биты за пределами длины
+    if ((len % (sizeof(TELEM) * 8) != 0) &&
+        (mem[memLen - 1] >> (len % (sizeof(TELEM) * 8)) != 0))
+      throw runtime_error("nonzero bits beyond binary bitfield length");
+    Field.BitLen = len;
+    Field.MemLen = memLen;
+    Field.pMem = mem;
+  }
+  catch (...)
+  {
+    Unmap();
+    throw;
+  }
+#else
+  (void)name;
+  (void)verify;
+  throw runtime_error("memory mapped bitfields are not supported on this platform");
+#endif
+}
+
+TMappedBitField::~TMappedBitField()
+{
+  Unmap();
+}
+
+void TMappedBitField::Unmap(void) // вернуть полю встроенную память, снять отображение
+{
+  Field.pMem = Field.Local;
+  Field.BitLen = Field.MemLen = 0;
+#ifdef BITFIELD_MMAP
+  if (pMap)
+    munmap(pMap, MapSize);
+#endif
+  pMap = 0;
+}
+
+const TBitField &TMappedBitField::GetField(void) const
+{
+  return Field;
+}
+
+TMappedBitField::operator const TBitField &(void) const
+{
+  return Field;
+}
+
+TMappedBitField::TMode TMappedBitField::GetMode(void) const
+{
+  return Mode;
+}
+
+// доступ к битам
+
+int TMappedBitField::GetLength(void) const
+{
+  return Field.GetLength();
+}
+
+int TMappedBitField::GetBit(const int n) const
+{
+  return Field.GetBit(n);
+}
+
+int TMappedBitField::Count(void) const
+{
+  return Field.Count();
+}
+
+int TMappedBitField::CountRange(const int lo, const int hi) const
+{
+  return Field.CountRange(lo, hi);
+}
+
+int TMappedBitField::FindFirst(void) const
+{
+  return Field.FindFirst();
+}
+
+int TMappedBitField::FindLast(void) const
+{
+  return Field.FindLast();
+}
+
+int TMappedBitField::FindNext(const int n) const
+{
+  return Field.FindNext(n);
+}
+
+int TMappedBitField::FindPrev(const int n) const
+{
+  return Field.FindPrev(n);
+}
+
+TBitIterator TMappedBitField::begin(void) const
+{
+  return Field.begin();
+}
+
+TBitIterator TMappedBitField::end(void) const
+{
+  return Field.end();
+}
+
+void TMappedBitField::SetBit(const int n)
+{
+  if (Mode != CopyOnWrite)
+    throw logic_error("read-only mapped bitfield");
+  Field.SetBit(n);
+}
+
+void TMappedBitField::ClrBit(const int n)
+{
+  if (Mode != CopyOnWrite)
+    throw logic_error("read-only mapped bitfield");
+  Field.ClrBit(n);
+}
+
+void TMappedBitField::Advise(TAccess a) const // подсказка о порядке доступа
+{
+#ifdef BITFIELD_MMAP
+  static const int advice[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+  if (pMap)
+    madvise(pMap, MapSize, advice[a]); // подсказка необязательна - ошибка не важна
+#else
+  (void)a;
+#endif
+}
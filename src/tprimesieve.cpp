@@ -0,0 +1,322 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// tprimesieve.cpp
+//
+// Сегментированное решето Эратосфена на битовых полях
+
+#include "tprimesieve.h"
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+static const int BitsInElem = sizeof(TELEM) * 8;
+
+static long long ISqrt(long long n) // целая часть квадратного корня
+{
+  long long r = (long long)sqrt((double)n);
+  while (r * r > n)
+    r--;
+  while ((r + 1) * (r + 1) <= n)
+    r++;
+  return r;
+}
+
+TPrimeSieve::TPrimeSieve(long long limit)
+  : TPrimeSieve(0, limit)
+{
+}
+
+TPrimeSieve::TPrimeSieve(long long low, long long limit)
+  : Wheel(WheelWords * BitsInElem), Segment(SegmentBits)
+{
+  if (limit > MaxLimit)
+    throw out_of_range("sieve limit is too large");
+  for (int i = 0; i < Wheel.GetLength(); i++)
+  {
+    int n = 2 * i + 1;
+    if ((n % 3 != 0) && (n % 5 != 0) && (n % 7 != 0))
+      Wheel.SetBit(i);
+  }
+  // простые до sqrt(limit) - простым решетом по нечетным числам
+  int root = (int)ISqrt((limit > 0) ? limit : 0);
+  TBitField odd((root + 1) / 2);
+  for (int i = 1; 2LL * i * i + 2 * i < odd.GetLength(); i++) // (2i+1)^2 = 4i^2+4i+1
+    if (!odd.GetBit(i))
+      for (int k = 2 * i * (i + 1); k < odd.GetLength(); k += 2 * i + 1)
+        odd.SetBit(k);
+  for (int i = 5; i < odd.GetLength(); i++) // с числа 11
+    if (!odd.GetBit(i))
+      Primes.push_back(2 * i + 1);
+  Next.resize(Primes.size());
+  Restart(low, limit);
+}
+
+void TPrimeSieve::Restart(long long low, long long limit) // перейти к диапазону
+{
+  Low = (low > 0) ? low : 0;
+  Limit = limit;
+  TwoDone = (Low > 2) || (Limit < 2);
+  // сегменты начинаются с номера, кратного BitsInElem, - шаблон
+  // копируется целыми словами
+  SegIndex = Low / 2 - (Low / 2) % BitsInElem - SegmentBits;
+  SegLen = 0;
+  Pos = -1;
+  for (size_t k = 0; k < Primes.size(); k++)
+  {
+    // первое нечетное кратное, не меньшее p * p и Low
+    long long p = Primes[k], m = p * p;
+    if (m < Low)
+      m = (Low + p - 1) / p * p;
+    if (m % 2 == 0)
+      m += p;
+    Next[k] = m / 2;
+  }
+}
+
+long long TPrimeSieve::GetLow(void) const
+{
+  return Low;
+}
+
+long long TPrimeSieve::GetLimit(void) const
+{
+  return Limit;
+}
+
+int TPrimeSieve::SieveNext(void) // просеять следующий сегмент
+{
+  long long last = (Limit - 1) / 2; // номер последнего нечетного числа <= Limit
+  SegIndex += SegmentBits;
+  if ((Limit < 3) || (SegIndex > last))
+  {
+    SegLen = 0;
+    return 0;
+  }
+  SegLen = (last - SegIndex + 1 < SegmentBits) ? (int)(last - SegIndex + 1) : SegmentBits;
+
+  // заполнение шаблоном; SegIndex кратен BitsInElem
+  TELEM *p = Segment.pMem;
+  int words = (SegLen + BitsInElem - 1) / BitsInElem;
+  int w = (int)((SegIndex / BitsInElem) % WheelWords);
+  for (int j = 0; j < words; j++)
+  {
+    p[j] = Wheel.pMem[w];
+    if (++w == WheelWords)
+      w = 0;
+  }
+  for (int j = words; j < Segment.MemLen; j++)
+    p[j] = 0;
+  if (SegLen % BitsInElem != 0)
+    p[words - 1] &= (TELEM(1) << (SegLen % BitsInElem)) - 1;
+  if (SegIndex == 0) // 1 не простое, 3, 5, 7 вычеркнуты шаблоном
+  {
+    p[0] &= ~TELEM(1);
+    for (int n = 3; (n <= 7) && (n <= Limit); n += 2)
+      p[0] |= TELEM(1) << (n / 2);
+  }
+  for (long long j = 0; j < Low / 2 - SegIndex; j++) // числа меньше Low
+    p[j / BitsInElem] &= ~(TELEM(1) << (j % BitsInElem));
+
+  // вычеркивание кратных простых, для которых p * p попадает в сегмент или
+  // раньше; простые больше сегмента могут не иметь в нем кратных
+  long long end = SegIndex + SegLen;
+  for (size_t k = 0; (k < Primes.size()) && ((long long)Primes[k] * Primes[k] / 2 < end); k++)
+  {
+    int step = Primes[k];
+    long long j = Next[k] - SegIndex;
+    for (; j < SegLen; j += step)
+      p[j / BitsInElem] &= ~(TELEM(1) << (j % BitsInElem));
+    Next[k] = SegIndex + j;
+  }
+  return 1;
+}
+
+long long TPrimeSieve::NextPrime(void) // следующее простое
+{
+  if (!TwoDone)
+  {
+    TwoDone = 1;
+    if (Limit >= 2)
+      return 2;
+  }
+  for (;;)
+  {
+    if (SegLen > 0)
+    {
+      int n = Segment.FindNext(Pos);
+      if (n >= 0)
+      {
+        Pos = n;
+        return 2 * (SegIndex + n) + 1;
+      }
+    }
+    if (!SieveNext())
+      return -1;
+    Pos = -1;
+  }
+}
+
+TPrimeIterator TPrimeSieve::begin(void)
+{
+  return TPrimeIterator(this, NextPrime());
+}
+
+TPrimeIterator TPrimeSieve::end(void)
+{
+  return TPrimeIterator(this, -1);
+}
+
+long long TPrimeSieve::CountPrimes(long long n) // к-во простых чисел <= n
+{
+  return CountPrimes(0, n);
+}
+
+long long TPrimeSieve::CountPrimes(long long low, long long n) // к-во от low до n
+{
+  TPrimeSieve s(low, n);
+  long long res = !s.TwoDone; // число 2
+  while (s.SieveNext())
+    res += s.Segment.Count();
+  return res;
+}
+
+// параллельный режим
+
+static int ThreadCount(int threads) // к-во потоков (threads <= 0 - по к-ву ядер)
+{
+  if (threads <= 0)
+    threads = (int)thread::hardware_concurrency();
+  return (threads > 0) ? threads : 1;
+}
+
+// длина части в числах: не больше max, кратна длине сегмента
+static long long ChunkSize(long long low, long long n, int parts, long long seg, long long max)
+{
+  long long len = (n - low + parts) / parts;
+  len = (len + seg - 1) / seg * seg;
+  return (len < max) ? len : max;
+}
+
+long long TPrimeSieve::CountPrimes(long long low, long long n, int threads)
+{
+  threads = ThreadCount(threads);
+  if (low < 0)
+    low = 0;
+  if ((threads == 1) || (n < low))
+    return CountPrimes(low, n);
+  // частей в несколько раз больше потоков - для выравнивания нагрузки
+  const TPrimeSieve base(low, n);
+  long long size = ChunkSize(low, n, 8 * threads, 2LL * SegmentBits, n);
+  long long chunks = (n - low) / size + 1;
+  atomic<long long> next(0), total(0);
+  auto work = [&] {
+    TPrimeSieve s(base);
+    for (long long c; (c = next++) < chunks;)
+    {
+      long long lo = low + c * size, hi = (n - lo < size) ? n : lo + size - 1;
+      s.Restart(lo, hi);
+      long long res = !s.TwoDone;
+      while (s.SieveNext())
+        res += s.Segment.Count();
+      total += res;
+    }
+  };
+  vector<thread> pool;
+  for (int t = 1; t < threads; t++)
+    pool.push_back(thread(work));
+  work();
+  for (size_t t = 0; t < pool.size(); t++)
+    pool[t].join();
+  return total;
+}
+
+void TPrimeSieve::VisitPrimes(long long low, long long n, int threads,
+                              TPrimeVisitor visit, void *ctx)
+{
+  threads = ThreadCount(threads);
+  if (low < 0)
+    low = 0;
+  if ((threads == 1) || (n < low))
+  {
+    TPrimeSieve s(low, n);
+    for (long long p = s.NextPrime(); p != -1; p = s.NextPrime())
+      visit(p, ctx);
+    return;
+  }
+  // части ограничены 64 сегментами, чтобы буферы простых были невелики
+  const TPrimeSieve base(low, n);
+  long long size = ChunkSize(low, n, 8 * threads, 2LL * SegmentBits, 128LL * SegmentBits);
+  long long chunks = (n - low) / size + 1;
+  const int window = 2 * threads;
+  vector<vector<long long> > slots(window); // простые готовых частей
+  vector<long long> ready(window, -1);      // номер части в слоте (-1 - слот свободен)
+  long long next = 0, consumed = 0;         // следующая выдаваемая и выданная части
+  int stop = 0;
+  mutex lock;
+  condition_variable changed;
+
+  auto work = [&] {
+    TPrimeSieve s(base);
+    vector<long long> buf;
+    for (;;)
+    {
+      long long c;
+      {
+        unique_lock<mutex> lk(lock);
+        c = next++;
+        // часть строится, только когда для нее есть слот
+        changed.wait(lk, [&] { return stop || (c >= chunks) || (c < consumed + window); });
+        if (stop || (c >= chunks))
+          return;
+      }
+      long long lo = low + c * size, hi = (n - lo < size) ? n : lo + size - 1;
+      s.Restart(lo, hi);
+      buf.clear();
+      for (long long p = s.NextPrime(); p != -1; p = s.NextPrime())
+        buf.push_back(p);
+      lock_guard<mutex> lk(lock);
+      slots[c % window].swap(buf);
+      ready[c % window] = c;
+      changed.notify_all();
+    }
+  };
+  vector<thread> pool;
+  for (int t = 0; t < threads; t++)
+    pool.push_back(thread(work));
+  auto finish = [&] {
+    {
+      lock_guard<mutex> lk(lock);
+      stop = 1;
+    }
+    changed.notify_all();
+    for (size_t t = 0; t < pool.size(); t++)
+      pool[t].join();
+  };
+  try
+  {
+    vector<long long> buf;
+    for (long long c = 0; c < chunks; c++)
+    {
+      {
+        unique_lock<mutex> lk(lock);
+        changed.wait(lk, [&] { return ready[c % window] == c; });
+        buf.swap(slots[c % window]);
+        ready[c % window] = -1;
+        consumed = c + 1;
+      }
+      changed.notify_all();
+      for (size_t i = 0; i < buf.size(); i++)
+        visit(buf[i], ctx);
+    }
+  }
+  catch (...)
+  {
+    finish();
+    throw;
+  }
+  finish();
+}
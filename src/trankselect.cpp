@@ -0,0 +1,194 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// trankselect.cpp
+//
+// Индекс ранга и выбора над битовым полем
+
+#include "trankselect.h"
+#include "tbitops.h"
+
+#include <stdexcept>
+
+static const int BitsInElem  = sizeof(TELEM) * 8;
+static const int BlockBits   = 512;                  // блок
+static const int BasicBits   = 4 * BlockBits;        // базовый блок
+static const int BlockElems  = BlockBits / BitsInElem;
+static const int BasicElems  = BasicBits / BitsInElem;
+static const int SelectStep  = 8192;                 // шаг выборок для Select
+static const unsigned long long LowMask = 0xffffffffull;
+
+TRankSelect::TRankSelect(TBitField &bf) : pField(&bf)
+{
+  Build();
+}
+
+void TRankSelect::Build(void) // построение индекса за один проход по полю
+{
+  const TELEM *pMem = pField->pMem;
+  int MemLen = pField->MemLen;
+  int nb = (MemLen + BasicElems - 1) / BasicElems;
+  unsigned long long cum = 0;
+
+  BitLen = pField->BitLen;
+  this->pMem = pMem;
+  Changes = pField->Changes;
+  Index.assign(nb + 1, 0);
+  for (int b = 0; b < nb; b++)
+  {
+    unsigned long long entry = cum;
+    for (int sub = 0; sub < 4; sub++)
+    {
+      int start = b * BasicElems + sub * BlockElems;
+      int len = MemLen - start;
+      if (len > BlockElems)
+        len = BlockElems;
+      unsigned long long cnt = (len > 0) ? BitCount(pMem + start, len) : 0;
+      if (sub < 3)
+        entry |= cnt << (32 + 10 * sub);
+      cum += cnt;
+    }
+    Index[b] = entry;
+  }
+  Index[nb] = cum;
+  Total = (int)cum;
+  BuildSamples();
+}
+
+void TRankSelect::BuildSamples(void) const
+{
+  int nb = (int)Index.size() - 1;
+  Samples.clear();
+  for (int b = 0; b < nb; b++)
+    while ((long long)Samples.size() * SelectStep < (long long)(Index[b + 1] & LowMask))
+      Samples.push_back(b);
+  SamplesValid = 1;
+}
+
+int TRankSelect::BlockCount(int b, int sub) const // к-во единиц в блоке
+{
+  unsigned long long e = Index[b];
+  if (sub < 3)
+    return (int)((e >> (32 + 10 * sub)) & 0x3ff);
+  // четвертый блок не хранится: остаток от к-ва единиц базового блока
+  int cnt = (int)((Index[b + 1] & LowMask) - (e & LowMask));
+  for (int j = 0; j < 3; j++)
+    cnt -= (int)((e >> (32 + 10 * j)) & 0x3ff);
+  return cnt;
+}
+
+int TRankSelect::IsFresh(void) const // соответствует ли индекс полю
+{
+  return (pField->Changes == Changes) && (pField->pMem == pMem) && (pField->BitLen == BitLen);
+}
+
+void TRankSelect::CheckFresh(void) const
+{
+  if (!IsFresh())
+    throw logic_error("bitfield changed after the rank/select index was built");
+}
+
+int TRankSelect::GetCount(void) const // к-во установленных битов
+{
+  CheckFresh();
+  return Total;
+}
+
+int TRankSelect::IndexSize(void) const // объем индекса в байтах
+{
+  return (int)(Index.size() * sizeof(Index[0]) + Samples.size() * sizeof(Samples[0]));
+}
+
+int TRankSelect::Rank(const int n) const // к-во единиц с номерами < n
+{
+  if ((n < 0) || (n > BitLen))
+    throw out_of_range("bit index out of range");
+  CheckFresh();
+  int b = n / BasicBits, sub = (n % BasicBits) / BlockBits;
+  unsigned long long e = Index[b];
+  int res = (int)(e & LowMask);
+  for (int j = 0; j < sub; j++)
+    res += (int)((e >> (32 + 10 * j)) & 0x3ff);
+  int w = b * BasicElems + sub * BlockElems, last = n / BitsInElem;
+  for (; w < last; w++)
+    res += BitPopcount(pMem[w]);
+  if (n % BitsInElem != 0)
+    res += BitPopcount(pMem[last] & ((TELEM(1) << (n % BitsInElem)) - 1));
+  return res;
+}
+
+int TRankSelect::Select(const int k) const // номер k-го установленного бита
+{
+  CheckFresh();
+  if ((k < 0) || (k >= Total))
+    throw out_of_range("rank out of range");
+  if (!SamplesValid)
+    BuildSamples();
+  int memLen = pField->MemLen;
+  int s = k / SelectStep;
+  int lo = Samples[s];
+  int hi = (s + 1 < (int)Samples.size()) ? Samples[s + 1] : (int)Index.size() - 2;
+  // последний базовый блок, перед которым не больше k единиц
+  while (lo < hi)
+  {
+    int mid = (lo + hi + 1) / 2;
+    if ((int)(Index[mid] & LowMask) <= k)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  int rem = k - (int)(Index[lo] & LowMask);
+  int sub = 0;
+  for (; sub < 3; sub++)
+  {
+    int cnt = BlockCount(lo, sub);
+    if (rem < cnt)
+      break;
+    rem -= cnt;
+  }
+  int w = lo * BasicElems + sub * BlockElems;
+  for (; w < memLen; w++)
+  {
+    int cnt = BitPopcount(pMem[w]);
+    if (rem < cnt)
+      break;
+    rem -= cnt;
+  }
+  if (w == memLen) // индекс не соответствует полю
+    throw logic_error("rank/select index is inconsistent with bitfield");
+  TELEM x = pMem[w];
+  for (; rem > 0; rem--)
+    x &= x - 1; // сбросить младшие единицы
+  return w * BitsInElem + BitLowest(x);
+}
+
+void TRankSelect::SetBit(const int n) // установить бит с обновлением индекса
+{
+  CheckFresh();
+  if (pField->GetBit(n))
+    return;
+  pField->SetBit(n);
+  Changes = pField->Changes;
+  int b = n / BasicBits, sub = (n % BasicBits) / BlockBits;
+  if (sub < 3)
+    Index[b] += 1ull << (32 + 10 * sub);
+  for (int j = b + 1; j < (int)Index.size(); j++)
+    Index[j]++;
+  Total++;
+  SamplesValid = 0;
+}
+
+void TRankSelect::ClrBit(const int n) // очистить бит с обновлением индекса
+{
+  CheckFresh();
+  if (!pField->GetBit(n))
+    return;
+  pField->ClrBit(n);
+  Changes = pField->Changes;
+  int b = n / BasicBits, sub = (n % BasicBits) / BlockBits;
+  if (sub < 3)
+    Index[b] -= 1ull << (32 + 10 * sub);
+  for (int j = b + 1; j < (int)Index.size(); j++)
+    Index[j]--;
+  Total--;
+  SamplesValid = 0;
+}
@@ -0,0 +1,774 @@
+// ННГУ, ВМК, Курс "Методы программирования-2", С++, ООП
+//
+// troaringset.cpp
+//
+// Множество - сжатое представление в стиле Roaring
+
+#include "troaringset.h"
+#include "tbitops.h"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+#include <stdexcept>
+
+typedef unsigned long long TWord64;
+typedef vector<TWord64> TBitmap;
+
+static const int ChunkBits   = 1 << 16;        // элементов во фрагменте
+static const int ArrayMax    = 4096;           // наибольший размер массива
+static const int BitmapWords = ChunkBits / 64; // слов в битовой шкале
+
+// операции над контейнерами
+
+static int NextSet(const TBitmap &bits, int p) // первый единичный бит >= p
+{
+  if (p >= ChunkBits)
+    return -1;
+  int w = p >> 6;
+  TWord64 x = bits[w] & (~0ull << (p & 63));
+  while (x == 0)
+  {
+    if (++w == BitmapWords)
+      return -1;
+    x = bits[w];
+  }
+  return (w << 6) + BitLowest(x);
+}
+
+static int NextClear(const TBitmap &bits, int p) // первый нулевой бит >= p
+{
+  if (p >= ChunkBits)
+    return ChunkBits;
+  int w = p >> 6;
+  TWord64 x = ~bits[w] & (~0ull << (p & 63));
+  while (x == 0)
+  {
+    if (++w == BitmapWords)
+      return ChunkBits;
+    x = ~bits[w];
+  }
+  return (w << 6) + BitLowest(x);
+}
+
+static void SetRange(TBitmap &bits, int lo, int hi) // установить биты lo..hi
+{
+  for (int w = lo >> 6; w <= (hi >> 6); w++)
+  {
+    TWord64 m = ~0ull;
+    if (w == (lo >> 6))
+      m &= ~0ull << (lo & 63);
+    if (w == (hi >> 6))
+      m &= ~0ull >> (63 - (hi & 63));
+    bits[w] |= m;
+  }
+}
+
+static void ToBitmap(const TRoaringContainer &c, TBitmap &bits)
+{
+  if (c.Type == ROARING_BITMAP)
+  {
+    bits = c.Bits;
+    return;
+  }
+  bits.assign(BitmapWords, 0);
+  if (c.Type == ROARING_ARRAY)
+    for (size_t i = 0; i < c.Data.size(); i++)
+      bits[c.Data[i] >> 6] |= 1ull << (c.Data[i] & 63);
+  else
+    for (size_t i = 0; i < c.Data.size(); i += 2)
+      SetRange(bits, c.Data[i], c.Data[i] + c.Data[i + 1]);
+}
+
+// серии компактнее массива и битовой шкалы (по 4 байта на серию)
+static int RunsFit(int runs, int card)
+{
+  return (4 * runs < 2 * card) && (4 * runs < BitmapWords * 8);
+}
+
+// построение контейнера самого компактного вида по битовой шкале
+static void FromBitmap(TRoaringContainer &c, TBitmap &bits)
+{
+  int card = 0, runs = 0;
+  TWord64 prev = 0;
+  for (int i = 0; i < BitmapWords; i++)
+  {
+    TWord64 w = bits[i];
+    card += BitPopcount(w);
+    runs += BitPopcount(w & ~((w << 1) | (prev >> 63))); // начала серий
+    prev = w;
+  }
+  c.Card = card;
+  c.Data.clear();
+  c.Bits.clear();
+  if (RunsFit(runs, card))
+  {
+    c.Type = ROARING_RUN;
+    c.Data.reserve(2 * runs);
+    for (int p = NextSet(bits, 0); p >= 0; )
+    {
+      int end = NextClear(bits, p);
+      c.Data.push_back((unsigned short)p);
+      c.Data.push_back((unsigned short)(end - p - 1));
+      p = NextSet(bits, end);
+    }
+  }
+  else if (card <= ArrayMax)
+  {
+    c.Type = ROARING_ARRAY;
+    c.Data.reserve(card);
+    for (int i = 0; i < BitmapWords; i++)
+      for (TWord64 w = bits[i]; w != 0; w &= w - 1)
+        c.Data.push_back((unsigned short)((i << 6) + BitLowest(w)));
+  }
+  else
+  {
+    c.Type = ROARING_BITMAP;
+    c.Bits.swap(bits);
+  }
+}
+
+static void MakeArray(TRoaringContainer &c, vector<unsigned short> &arr)
+{
+  c.Card = (int)arr.size();
+  if (c.Card > ArrayMax)
+  {
+    TBitmap bits(BitmapWords, 0);
+    for (size_t i = 0; i < arr.size(); i++)
+      bits[arr[i] >> 6] |= 1ull << (arr[i] & 63);
+    c.Type = ROARING_BITMAP;
+    c.Data.clear();
+    c.Bits.swap(bits);
+    return;
+  }
+  c.Type = ROARING_ARRAY;
+  c.Bits.clear();
+  c.Data.swap(arr);
+}
+
+static int RunIndex(const TRoaringContainer &c, unsigned short low) // серия, начинающаяся
+{                                                                     // не позже low, или -1
+  int lo = -1, hi = (int)c.Data.size() / 2 - 1;
+  while (lo < hi)
+  {
+    int mid = (lo + hi + 1) / 2;
+    if (c.Data[2 * mid] <= low)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+static int Contains(const TRoaringContainer &c, unsigned short low)
+{
+  switch (c.Type)
+  {
+    case ROARING_ARRAY:
+      return binary_search(c.Data.begin(), c.Data.end(), low);
+    case ROARING_BITMAP:
+      return (c.Bits[low >> 6] >> (low & 63)) & 1;
+    case ROARING_RUN:
+    {
+      int r = RunIndex(c, low);
+      return (r >= 0) && (low <= c.Data[2 * r] + c.Data[2 * r + 1]);
+    }
+  }
+  return 0;
+}
+
+static void Insert(TRoaringContainer &c, unsigned short low) // low отсутствует
+{
+  if (c.Type == ROARING_ARRAY)
+  {
+    c.Data.insert(lower_bound(c.Data.begin(), c.Data.end(), low), low);
+    MakeArray(c, c.Data);
+  }
+  else if (c.Type == ROARING_BITMAP)
+  {
+    c.Bits[low >> 6] |= 1ull << (low & 63);
+    c.Card++;
+  }
+  else
+  {
+    // серии меняются на месте: low продлевает соседнюю серию, сливает
+    // две серии или образует новую
+    vector<unsigned short> &d = c.Data;
+    int r = RunIndex(c, low), n = (int)d.size() / 2;
+    int joinPrev = (r >= 0) && (d[2 * r] + d[2 * r + 1] + 1 == low);
+    int joinNext = (r + 1 < n) && (d[2 * r + 2] == low + 1);
+    if (joinPrev && joinNext)
+    {
+      d[2 * r + 1] = (unsigned short)(d[2 * r + 1] + d[2 * r + 3] + 2);
+      d.erase(d.begin() + 2 * r + 2, d.begin() + 2 * r + 4);
+    }
+    else if (joinPrev)
+      d[2 * r + 1]++;
+    else if (joinNext)
+    {
+      d[2 * r + 2] = low;
+      d[2 * r + 3]++;
+    }
+    else
+    {
+      unsigned short run[2] = { low, 0 };
+      d.insert(d.begin() + 2 * (r + 1), run, run + 2);
+    }
+    c.Card++;
+    if (!RunsFit((int)d.size() / 2, c.Card)) // серий стало слишком много
+    {
+      TBitmap bits;
+      ToBitmap(c, bits);
+      FromBitmap(c, bits);
+    }
+  }
+}
+
+static void Remove(TRoaringContainer &c, unsigned short low) // low присутствует
+{
+  if (c.Type == ROARING_ARRAY)
+  {
+    c.Data.erase(lower_bound(c.Data.begin(), c.Data.end(), low));
+    c.Card--;
+  }
+  else if ((c.Type == ROARING_BITMAP) && (c.Card - 1 > ArrayMax))
+  {
+    c.Bits[low >> 6] &= ~(1ull << (low & 63));
+    c.Card--;
+  }
+  else if (c.Type == ROARING_RUN)
+  {
+    // серия, содержащая low, укорачивается, делится на две или исчезает
+    vector<unsigned short> &d = c.Data;
+    int r = RunIndex(c, low);
+    int start = d[2 * r], end = start + d[2 * r + 1];
+    if (start == end)
+      d.erase(d.begin() + 2 * r, d.begin() + 2 * r + 2);
+    else if (low == start)
+    {
+      d[2 * r] = (unsigned short)(low + 1);
+      d[2 * r + 1]--;
+    }
+    else if (low == end)
+      d[2 * r + 1]--;
+    else
+    {
+      d[2 * r + 1] = (unsigned short)(low - start - 1);
+      unsigned short run[2] = { (unsigned short)(low + 1), (unsigned short)(end - low - 1) };
+      d.insert(d.begin() + 2 * r + 2, run, run + 2);
+    }
+    c.Card--;
+    if ((c.Card > 0) && !RunsFit((int)d.size() / 2, c.Card))
+    {
+      TBitmap bits;
+      ToBitmap(c, bits);
+      FromBitmap(c, bits);
+    }
+  }
+  else // битовая шкала становится массивом
+  {
+    TBitmap bits;
+    ToBitmap(c, bits);
+    bits[low >> 6] &= ~(1ull << (low & 63));
+    FromBitmap(c, bits);
+  }
+}
+
+static void Union(const TRoaringContainer &a, const TRoaringContainer &b,
+                  TRoaringContainer &res)
+{
+  res.Key = a.Key;
+  if ((a.Type == ROARING_ARRAY) && (b.Type == ROARING_ARRAY))
+  {
+    vector<unsigned short> arr;
+    arr.reserve(a.Data.size() + b.Data.size());
+    set_union(a.Data.begin(), a.Data.end(), b.Data.begin(), b.Data.end(),
+              back_inserter(arr));
+    MakeArray(res, arr);
+    return;
+  }
+  TBitmap x, y;
+  ToBitmap(a, x);
+  ToBitmap(b, y);
+  BitOr(&x[0], &x[0], &y[0], BitmapWords);
+  FromBitmap(res, x);
+}
+
+static void Intersect(const TRoaringContainer &a, const TRoaringContainer &b,
+                      TRoaringContainer &res)
+{
+  res.Key = a.Key;
+  if ((a.Type == ROARING_ARRAY) || (b.Type == ROARING_ARRAY))
+  {
+    const TRoaringContainer &arr = (a.Type == ROARING_ARRAY) ? a : b;
+    const TRoaringContainer &oth = (a.Type == ROARING_ARRAY) ? b : a;
+    vector<unsigned short> out;
+    if (oth.Type == ROARING_ARRAY)
+      set_intersection(arr.Data.begin(), arr.Data.end(),
+                       oth.Data.begin(), oth.Data.end(), back_inserter(out));
+    else
+      for (size_t i = 0; i < arr.Data.size(); i++)
+        if (Contains(oth, arr.Data[i]))
+          out.push_back(arr.Data[i]);
+    MakeArray(res, out);
+    return;
+  }
+  TBitmap x, y;
+  ToBitmap(a, x);
+  ToBitmap(b, y);
+  BitAnd(&x[0], &x[0], &y[0], BitmapWords);
+  FromBitmap(res, x);
+}
+
+// дополнение в пределах первых len элементов фрагмента
+static void Complement(const TRoaringContainer &c, int len, TRoaringContainer &res)
+{
+  TBitmap bits;
+  ToBitmap(c, bits);
+  BitNot(&bits[0], &bits[0], BitmapWords);
+  for (int w = len >> 6; w < BitmapWords; w++)
+    bits[w] &= (w == (len >> 6)) ? ~(~0ull << (len & 63)) : 0;
+  res.Key = c.Key;
+  FromBitmap(res, bits);
+}
+
+static int Equal(const TRoaringContainer &a, const TRoaringContainer &b)
+{
+  if ((a.Key != b.Key) || (a.Card != b.Card))
+    return 0;
+  if ((a.Type == b.Type) && (a.Type != ROARING_BITMAP))
+    return a.Data == b.Data;
+  TBitmap x, y;
+  ToBitmap(a, x);
+  ToBitmap(b, y);
+  return x == y;
+}
+
+// обход элементов контейнера по возрастанию
+template <class TFunc>
+static void ForEach(const TRoaringContainer &c, TFunc f)
+{
+  int base = int(c.Key) << 16;
+  if (c.Type == ROARING_ARRAY)
+    for (size_t i = 0; i < c.Data.size(); i++)
+      f(base + c.Data[i]);
+  else if (c.Type == ROARING_RUN)
+    for (size_t i = 0; i < c.Data.size(); i += 2)
+      for (int e = c.Data[i]; e <= c.Data[i] + c.Data[i + 1]; e++)
+        f(base + e);
+  else
+    for (int i = 0; i < BitmapWords; i++)
+      for (TWord64 w = c.Bits[i]; w != 0; w &= w - 1)
+        f(base + (i << 6) + BitLowest(w));
+}
+
+// множество
+
+TRoaringSet::TRoaringSet(int mp)
+{
+  if (mp < 0)
+    throw invalid_argument("negative set power");
+  MaxPower = mp;
+}
+
+// конструктор преобразования типа: слова поля множества переносятся
+// в битовую шкалу фрагмента целиком, контейнер строится один раз
+TRoaringSet::TRoaringSet(const TSet &s)
+{
+  MaxPower = s.GetMaxPower();
+  const TBitField &bf = s.BitField;
+  const int chunkElems = ChunkBits / (sizeof(TELEM) * 8); // слов поля во фрагменте
+  TBitmap bits;
+  for (int lo = 0; lo < bf.MemLen; lo += chunkElems)
+  {
+    int n = (bf.MemLen - lo < chunkElems) ? bf.MemLen - lo : chunkElems;
+    if (BitCount(bf.pMem + lo, n) == 0)
+      continue;
+    bits.assign(BitmapWords, 0);
+    for (int i = 0; i < n; i++)
+      bits[i * sizeof(TELEM) / 8] |= TWord64(bf.pMem[lo + i]) << (i * sizeof(TELEM) * 8 % 64);
+    TRoaringContainer c;
+    c.Key = (unsigned short)(lo / chunkElems);
+    FromBitmap(c, bits);
+    Cont.push_back(c);
+  }
+}
+
+TRoaringSet::operator TSet() const
+{
+  TSet res(MaxPower);
+  for (size_t i = 0; i < Cont.size(); i++)
+    ForEach(Cont[i], [&res](int e) { res.InsElem(e); });
+  return res;
+}
+
+int TRoaringSet::Find(unsigned short key) const // контейнер с ключом key
+{
+  int lo = 0, hi = (int)Cont.size() - 1;
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (Cont[mid].Key == key)
+      return mid;
+    if (Cont[mid].Key < key)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+  return -1;
+}
+
+int TRoaringSet::GetMaxPower(void) const // получить макс. к-во эл-тов
+{
+  return MaxPower;
+}
+
+int TRoaringSet::Cardinality(void) const // к-во элементов
+{
+  int res = 0;
+  for (size_t i = 0; i < Cont.size(); i++)
+    res += Cont[i].Card;
+  return res;
+}
+
+int TRoaringSet::IsMember(const int Elem) const // элемент множества?
+{
+  if ((Elem < 0) || (Elem >= MaxPower))
+    throw out_of_range("set element out of range");
+  int i = Find((unsigned short)(Elem >> 16));
+  return (i >= 0) && Contains(Cont[i], (unsigned short)Elem);
+}
+
+void TRoaringSet::InsElem(const int Elem) // включение элемента множества
+{
+  if ((Elem < 0) || (Elem >= MaxPower))
+    throw out_of_range("set element out of range");
+  unsigned short key = (unsigned short)(Elem >> 16), low = (unsigned short)Elem;
+  vector<TRoaringContainer>::iterator it = lower_bound(Cont.begin(), Cont.end(), key,
+    [](const TRoaringContainer &c, unsigned short k) { return c.Key < k; });
+  if ((it == Cont.end()) || (it->Key != key))
+  {
+    TRoaringContainer c;
+    c.Key = key;
+    c.Type = ROARING_ARRAY;
+    c.Card = 1;
+    c.Data.push_back(low);
+    Cont.insert(it, c);
+  }
+  else if (!Contains(*it, low))
+    Insert(*it, low);
+}
+
+void TRoaringSet::DelElem(const int Elem) // исключение элемента множества
+{
+  if ((Elem < 0) || (Elem >= MaxPower))
+    throw out_of_range("set element out of range");
+  int i = Find((unsigned short)(Elem >> 16));
+  if ((i < 0) || !Contains(Cont[i], (unsigned short)Elem))
+    return;
+  Remove(Cont[i], (unsigned short)Elem);
+  if (Cont[i].Card == 0)
+    Cont.erase(Cont.begin() + i);
+}
+
+// представление
+
+void TRoaringSet::RunOptimize(void) // самый компактный вид контейнеров
+{
+  TBitmap bits;
+  for (size_t i = 0; i < Cont.size(); i++)
+  {
+    ToBitmap(Cont[i], bits);
+    FromBitmap(Cont[i], bits);
+  }
+}
+
+int TRoaringSet::ContainerCount(void) const // к-во контейнеров
+{
+  return (int)Cont.size();
+}
+
+int TRoaringSet::MemoryUsage(void) const // объем данных в байтах
+{
+  size_t res = Cont.size() * sizeof(TRoaringContainer);
+  for (size_t i = 0; i < Cont.size(); i++)
+    res += Cont[i].Data.size() * sizeof(unsigned short) +
+           Cont[i].Bits.size() * sizeof(TWord64);
+  return (int)res;
+}
+
+// теоретико-множественные операции
+
+int TRoaringSet::operator==(const TRoaringSet &s) const // сравнение
+{
+  if ((MaxPower != s.MaxPower) || (Cont.size() != s.Cont.size()))
+    return 0;
+  for (size_t i = 0; i < Cont.size(); i++)
+    if (!Equal(Cont[i], s.Cont[i]))
+      return 0;
+  return 1;
+}
+
+int TRoaringSet::operator!=(const TRoaringSet &s) const // сравнение
+{
+  return !(*this == s);
+}
+
+TRoaringSet TRoaringSet::operator+(const int Elem) const // объединение с элементом
+{
+  TRoaringSet res(*this);
+  res.InsElem(Elem);
+  return res;
+}
+
+TRoaringSet TRoaringSet::operator-(const int Elem) const // разность с элементом
+{
+  TRoaringSet res(*this);
+  res.DelElem(Elem);
+  return res;
+}
+
+TRoaringSet TRoaringSet::operator+(const TRoaringSet &s) const // объединение
+{
+  TRoaringSet res(max(MaxPower, s.MaxPower));
+  size_t i = 0, j = 0;
+  res.Cont.reserve(Cont.size() + s.Cont.size());
+  while ((i < Cont.size()) || (j < s.Cont.size()))
+  {
+    if ((j == s.Cont.size()) || ((i < Cont.size()) && (Cont[i].Key < s.Cont[j].Key)))
+      res.Cont.push_back(Cont[i++]);
+    else if ((i == Cont.size()) || (s.Cont[j].Key < Cont[i].Key))
+      res.Cont.push_back(s.Cont[j++]);
+    else
+    {
+      res.Cont.push_back(TRoaringContainer());
+      Union(Cont[i++], s.Cont[j++], res.Cont.back());
+    }
+  }
+  return res;
+}
+
+TRoaringSet TRoaringSet::operator*(const TRoaringSet &s) const // пересечение
+{
+  TRoaringSet res(max(MaxPower, s.MaxPower));
+  size_t i = 0, j = 0;
+  while ((i < Cont.size()) && (j < s.Cont.size()))
+  {
+    if (Cont[i].Key < s.Cont[j].Key)
+      i++;
+    else if (s.Cont[j].Key < Cont[i].Key)
+      j++;
+    else
+    {
+      TRoaringContainer c;
+      Intersect(Cont[i++], s.Cont[j++], c);
+      if (c.Card > 0)
+        res.Cont.push_back(c);
+    }
+  }
+  return res;
+}
+
+TRoaringSet TRoaringSet::operator~(void) const // дополнение
+{
+  TRoaringSet res(MaxPower);
+  int chunks = (MaxPower + ChunkBits - 1) / ChunkBits;
+  size_t j = 0;
+  for (int key = 0; key < chunks; key++)
+  {
+    int len = min(ChunkBits, MaxPower - key * ChunkBits);
+    TRoaringContainer c;
+    if ((j < Cont.size()) && (Cont[j].Key == key))
+      Complement(Cont[j++], len, c);
+    else
+    {
+      // пустой фрагмент дополняется одной серией
+      c.Key = (unsigned short)key;
+      c.Type = ROARING_RUN;
+      c.Card = len;
+      c.Data.push_back(0);
+      c.Data.push_back((unsigned short)(len - 1));
+    }
+    if (c.Card > 0)
+      res.Cont.push_back(c);
+  }
+  return res;
+}
+
+TRoaringSet& TRoaringSet::operator+=(const TRoaringSet &s) // объединение на месте
+{
+  // как и у TSet, мощность универса левого операнда сохраняется
+  int mp = MaxPower;
+  *this = *this + s;
+  MaxPower = mp;
+  while (!Cont.empty() && (int(Cont.back().Key) << 16) >= mp)
+    Cont.pop_back();
+  if (!Cont.empty() && ((int(Cont.back().Key) + 1) << 16) > mp)
+  {
+    TRoaringContainer all, c;
+    all.Key = Cont.back().Key;
+    all.Type = ROARING_RUN;
+    all.Card = mp - (int(all.Key) << 16);
+    all.Data.push_back(0);
+    all.Data.push_back((unsigned short)(all.Card - 1));
+    Intersect(Cont.back(), all, c);
+    Cont.back() = c;
+    if (c.Card == 0)
+      Cont.pop_back();
+  }
+  return *this;
+}
+
+TRoaringSet& TRoaringSet::operator*=(const TRoaringSet &s) // пересечение на месте
+{
+  int mp = MaxPower;
+  *this = *this * s;
+  MaxPower = mp;
+  return *this;
+}
+
+// операции над многими множествами
+
+// добавить элементы контейнера к битовой шкале
+static void OrInto(TBitmap &bits, const TRoaringContainer &c)
+{
+  if (c.Type == ROARING_BITMAP)
+    BitOr(&bits[0], &bits[0], &c.Bits[0], BitmapWords);
+  else if (c.Type == ROARING_ARRAY)
+    for (size_t i = 0; i < c.Data.size(); i++)
+      bits[c.Data[i] >> 6] |= 1ull << (c.Data[i] & 63);
+  else
+    for (size_t i = 0; i < c.Data.size(); i += 2)
+      SetRange(bits, c.Data[i], c.Data[i] + c.Data[i + 1]);
+}
+
+TRoaringSet TRoaringSet::UnionAll(const TRoaringSet *const *sets, int k)
+{
+  if (k < 0)
+    throw invalid_argument("negative operand count");
+  int mp = 0;
+  for (int j = 0; j < k; j++)
+    mp = max(mp, sets[j]->MaxPower);
+  TRoaringSet res(mp);
+  // куча пар (ключ, номер множества); у каждого множества в куче -
+  // его очередной необработанный контейнер
+  typedef pair<unsigned short, int> TItem;
+  priority_queue<TItem, vector<TItem>, greater<TItem> > heap;
+  vector<size_t> pos(k, 0);
+  for (int j = 0; j < k; j++)
+    if (!sets[j]->Cont.empty())
+      heap.push(TItem(sets[j]->Cont[0].Key, j));
+  TBitmap bits;
+  vector<const TRoaringContainer *> group;
+  while (!heap.empty())
+  {
+    unsigned short key = heap.top().first;
+    group.clear();
+    while (!heap.empty() && (heap.top().first == key))
+    {
+      int j = heap.top().second;
+      heap.pop();
+      group.push_back(&sets[j]->Cont[pos[j]]);
+      if (++pos[j] < sets[j]->Cont.size())
+        heap.push(TItem(sets[j]->Cont[pos[j]].Key, j));
+    }
+    if (group.size() == 1)
+    {
+      res.Cont.push_back(*group[0]);
+      continue;
+    }
+    bits.assign(BitmapWords, 0);
+    for (size_t i = 0; i < group.size(); i++)
+      OrInto(bits, *group[i]);
+    res.Cont.push_back(TRoaringContainer());
+    res.Cont.back().Key = key;
+    FromBitmap(res.Cont.back(), bits);
+  }
+  return res;
+}
+
+TRoaringSet TRoaringSet::IntersectAll(const TRoaringSet *const *sets, int k)
+{
+  if (k < 0)
+    throw invalid_argument("negative operand count");
+  int mp = 0, least = 0;
+  for (int j = 0; j < k; j++)
+  {
+    mp = max(mp, sets[j]->MaxPower);
+    if (sets[j]->Cont.size() < sets[least]->Cont.size())
+      least = j;
+  }
+  TRoaringSet res(mp);
+  if (k == 0)
+    return res;
+  // ключи результата - подмножество ключей множества с наименьшим
+  // к-вом контейнеров; остальные множества проверяются двоичным поиском
+  const vector<TRoaringContainer> &base = sets[least]->Cont;
+  for (size_t i = 0; i < base.size(); i++)
+  {
+    TRoaringContainer c = base[i];
+    for (int j = 0; (j < k) && (c.Card > 0); j++)
+    {
+      if (j == least)
+        continue;
+      int p = sets[j]->Find(c.Key);
+      if (p < 0)
+        c.Card = 0;
+      else
+      {
+        TRoaringContainer t;
+        Intersect(c, sets[j]->Cont[p], t);
+        swap(c, t);
+      }
+    }
+    if (c.Card > 0)
+      res.Cont.push_back(c);
+  }
+  return res;
+}
+
+// перегрузка ввода/вывода
+
+istream &operator>>(istream &istr, TRoaringSet &s) // ввод
+{
+  // формат тот же, что и у TSet: {e1, e2, ...}
+  int Elem;
+  char c;
+  s.Cont.clear();
+  istr >> ws;
+  if (istr.peek() == '{')
+    istr.get();
+  while ((c = (istr >> ws).peek()) != EOF)
+  {
+    if (c == ',')
+    {
+      istr.get();
+      continue;
+    }
+    if (c == '}')
+    {
+      istr.get();
+      break;
+    }
+    if (!(istr >> Elem))
+      break;
+    s.InsElem(Elem);
+  }
+  return istr;
+}
+
+ostream &operator<<(ostream &ostr, const TRoaringSet &s) // вывод
+{
+  int first = 1;
+  ostr << '{';
+  for (size_t i = 0; i < s.Cont.size(); i++)
+    ForEach(s.Cont[i], [&](int e)
+    {
+      if (!first)
+        ostr << ", ";
+      ostr << e;
+      first = 0;
+    });
+  ostr << '}';
+  return ostr;
+}
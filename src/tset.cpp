@@ -6,94 +6,430 @@
 // Множество - реализация через битовые поля
 
 #include "tset.h"
+#include "tbitops.h"
 
-TSet::TSet(int mp) : BitField(-1)
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TSet::TSet(int mp, pmr::memory_resource *res) : BitField(mp, res)
 {
+  MaxPower = mp;
 }
 
 // конструктор копирования
-TSet::TSet(const TSet &s) : BitField(-1)
+TSet::TSet(const TSet &s) : BitField(s.BitField)
+{
+  MaxPower = s.MaxPower;
+}
+
+// конструктор перемещения
+TSet::TSet(TSet &&s) : BitField(std::move(s.BitField))
 {
+  MaxPower = s.MaxPower;
+  s.MaxPower = s.BitField.GetLength(); // 0, если память перенята
 }
 
 // конструктор преобразования типа
-TSet::TSet(const TBitField &bf) : BitField(-1)
+TSet::TSet(const TBitField &bf) : BitField(bf)
+{
+  MaxPower = bf.GetLength();
+}
+
+// преобразование типа с перемещением поля
+TSet::TSet(TBitField &&bf) : BitField(std::move(bf))
+{
+  MaxPower = BitField.GetLength();
+}
+
+TSet::operator TBitField() const &
 {
+  return BitField;
 }
 
-TSet::operator TBitField()
+TSet::operator TBitField() &&
 {
-    return TBitField(0);
+  MaxPower = 0;
+  return std::move(BitField);
 }
 
 int TSet::GetMaxPower(void) const // получить макс. к-во эл-тов
 {
-    return 0;
+  return MaxPower;
+}
+
+pmr::memory_resource *TSet::GetResource(void) const // источник памяти
+{
+  return BitField.GetResource();
+}
+
+int TSet::Cardinality(void) const // к-во элементов
+{
+  return BitField.Count();
 }
 
 int TSet::IsMember(const int Elem) const // элемент множества?
 {
-    return 0;
+  return BitField.GetBit(Elem);
+}
+
+int TSet::FindFirst(void) const // наименьший элемент
+{
+  return BitField.FindFirst();
+}
+
+int TSet::FindLast(void) const // наибольший элемент
+{
+  return BitField.FindLast();
+}
+
+int TSet::FindNext(const int Elem) const // следующий за Elem элемент
+{
+  return BitField.FindNext(Elem);
+}
+
+int TSet::FindPrev(const int Elem) const // предшествующий Elem элемент
+{
+  return BitField.FindPrev(Elem);
+}
+
+TBitIterator TSet::begin(void) const
+{
+  return BitField.begin();
+}
+
+TBitIterator TSet::end(void) const
+{
+  return BitField.end();
 }
 
 void TSet::InsElem(const int Elem) // включение элемента множества
 {
+  BitField.SetBit(Elem);
 }
 
 void TSet::DelElem(const int Elem) // исключение элемента множества
 {
+  BitField.ClrBit(Elem);
+}
+
+void TSet::InsRange(const int lo, const int hi) // включение элементов lo..hi-1
+{
+  BitField.SetRange(lo, hi);
+}
+
+void TSet::DelRange(const int lo, const int hi) // исключение элементов lo..hi-1
+{
+  BitField.ClrRange(lo, hi);
 }
 
 // теоретико-множественные операции
 
 TSet& TSet::operator=(const TSet &s) // присваивание
 {
-    return *this;
+  BitField = s.BitField;
+  MaxPower = s.MaxPower;
+  return *this;
+}
+
+TSet& TSet::operator=(TSet &&s) // присваивание с перемещением
+{
+  BitField = std::move(s.BitField);
+  MaxPower = s.MaxPower;
+  // при разных источниках памяти поле копируется и s сохраняет длину
+  s.MaxPower = s.BitField.GetLength();
+  return *this;
 }
 
 int TSet::operator==(const TSet &s) const // сравнение
 {
-    return 0;
+  return BitField == s.BitField;
 }
 
 int TSet::operator!=(const TSet &s) const // сравнение
 {
-    return 0;
+  return BitField != s.BitField;
+}
+
+TSet TSet::operator+(const TSet &s) const & // объединение
+{
+  return TSet(BitField | s.BitField);
 }
 
-TSet TSet::operator+(const TSet &s) // объединение
+TSet TSet::operator+(const int Elem) const & // объединение с элементом
 {
-    return TSet(0);
+  TSet res(*this);
+  res.InsElem(Elem);
+  return res;
 }
 
-TSet TSet::operator+(const int Elem) // объединение с элементом
+TSet TSet::operator-(const int Elem) const & // разность с элементом
 {
-    return TSet(0);
+  TSet res(*this);
+  res.DelElem(Elem);
+  return res;
 }
 
-TSet TSet::operator-(const int Elem) // разность с элементом
+TSet TSet::operator*(const TSet &s) const & // пересечение
 {
-    return TSet(0);
+  return TSet(BitField & s.BitField);
 }
 
-TSet TSet::operator*(const TSet &s) // пересечение
+TSet TSet::operator~(void) const & // дополнение
 {
-    return TSet(0);
+  return TSet(~BitField);
 }
 
-TSet TSet::operator~(void) // дополнение
+// операции над временными операндами
+
+TSet TSet::operator+(const int Elem) &&
+{
+  InsElem(Elem);
+  return std::move(*this);
+}
+
+TSet TSet::operator-(const int Elem) &&
 {
-    return TSet(0);
+  DelElem(Elem);
+  return std::move(*this);
+}
+
+TSet TSet::operator+(const TSet &s) &&
+{
+  return TSet(std::move(BitField) | s.BitField);
+}
+
+TSet TSet::operator+(TSet &&s) const &
+{
+  return TSet(BitField | std::move(s.BitField));
+}
+
+TSet TSet::operator+(TSet &&s) &&
+{
+  return TSet(std::move(BitField) | std::move(s.BitField));
+}
+
+TSet TSet::operator*(const TSet &s) &&
+{
+  return TSet(std::move(BitField) & s.BitField);
+}
+
+TSet TSet::operator*(TSet &&s) const &
+{
+  return TSet(BitField & std::move(s.BitField));
+}
+
+TSet TSet::operator*(TSet &&s) &&
+{
+  return TSet(std::move(BitField) & std::move(s.BitField));
+}
+
+TSet TSet::operator~(void) &&
+{
+  return TSet(~std::move(BitField));
+}
+
+// операции на месте
+
+TSet& TSet::operator+=(const TSet &s) // объединение
+{
+  BitField |= s.BitField;
+  return *this;
+}
+
+TSet& TSet::operator*=(const TSet &s) // пересечение
+{
+  BitField &= s.BitField;
+  return *this;
+}
+
+TSet& TSet::operator-=(const TSet &s) // разность
+{
+  BitField -= s.BitField;
+  return *this;
+}
+
+TSet& TSet::operator^=(const TSet &s) // симметрическая разность
+{
+  BitField ^= s.BitField;
+  return *this;
+}
+
+// операции над многими множествами
+
+TSet TSet::UnionAll(const TSet *const *sets, int k) // объединение k множеств
+{
+  vector<const TBitField *> f(k > 0 ? k : 0);
+  for (int j = 0; j < k; j++)
+    f[j] = &sets[j]->BitField;
+  return TSet(TBitField::UnionAll(f.data(), k));
+}
+
+TSet TSet::IntersectAll(const TSet *const *sets, int k) // пересечение k множеств
+{
+  vector<const TBitField *> f(k > 0 ? k : 0);
+  for (int j = 0; j < k; j++)
+    f[j] = &sets[j]->BitField;
+  return TSet(TBitField::IntersectAll(f.data(), k));
+}
+
+// двоичный формат - формат битового поля
+
+size_t TSet::SaveSize(void) const // размер записи
+{
+  return BitField.SaveSize();
+}
+
+void TSet::Save(ostream &ostr) const // запись в поток
+{
+  BitField.Save(ostr);
+}
+
+size_t TSet::Save(void *buf, size_t size) const // запись в буфер
+{
+  return BitField.Save(buf, size);
+}
+
+void TSet::Load(istream &istr) // чтение из потока
+{
+  BitField.Load(istr); // при ошибке поле и мощность универса не меняются
+  MaxPower = BitField.GetLength();
+}
+
+size_t TSet::Load(const void *buf, size_t size) // чтение из буфера
+{
+  size_t res = BitField.Load(buf, size);
+  MaxPower = BitField.GetLength();
+  return res;
 }
 
 // перегрузка ввода/вывода
 
+static int IsSpace(int c) // пробельный символ
+{
+  return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
 istream &operator>>(istream &istr, TSet &s) // ввод
 {
+  // формат: {e1, e2, ...}; фигурные скобки и запятые необязательны,
+  // чтение прекращается на '}' или на первом нечисловом символе;
+  // символы разбираются прямо из буфера потока, элементы записываются
+  // в слова поля
+  const int eof = char_traits<char>::eof(), bitsInElem = sizeof(TELEM) * 8;
+  TBitField &bf = s.BitField;
+  bf = TBitField(s.MaxPower);
+  if (!(istr >> ws))
     return istr;
+  streambuf *sb = istr.rdbuf();
+  int c = sb->sgetc();
+  if (c == '{')
+    c = sb->snextc();
+  for (;;)
+  {
+    while (IsSpace(c) || (c == ','))
+      c = sb->snextc();
+    if (c == eof)
+    {
+      istr.setstate(ios::eofbit);
+      break;
+    }
+    if (c == '}')
+    {
+      sb->sbumpc();
+      break;
+    }
+    int neg = (c == '-');
+    if ((c == '-') || (c == '+'))
+      c = sb->snextc();
+    unsigned int d = (unsigned int)(c - '0');
+    if (d > 9) // не число
+    {
+      istr.setstate(ios::failbit);
+      break;
+    }
+    long long Elem = 0;
+    for (; d <= 9; d = (unsigned int)((c = sb->snextc()) - '0'))
+      if (Elem <= INT_MAX)
+        Elem = Elem * 10 + d;
+    if (Elem > INT_MAX) // переполнение int, как при istr >> int
+    {
+      istr.setstate(ios::failbit);
+      break;
+    }
+    if ((neg && (Elem != 0)) || (Elem >= s.MaxPower))
+      throw out_of_range("set element out of range");
+    bf.pMem[Elem / bitsInElem] |= TELEM(1) << (Elem % bitsInElem);
+  }
+  return istr;
+}
+
+// пары цифр чисел 00..99
+static const char DigitPairs[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+static void Put2(char *p, unsigned int x) // две цифры, x < 100
+{
+  memcpy(p, DigitPairs + 2 * x, 2);
 }
 
+static void Put8(char *p, unsigned int x) // восемь цифр с ведущими нулями, x < 10^8
+{
+  // независимые половины - короче цепочка зависимых делений
+  unsigned int hi = x / 10000, lo = x % 10000;
+  Put2(p, hi / 100);
+  Put2(p + 2, hi % 100);
+  Put2(p + 4, lo / 100);
+  Put2(p + 6, lo % 100);
+}
+
+// запись числа из len цифр в buf[0..len-1]
+static void PutUInt(char *buf, unsigned int x, int len)
+{
+  char tmp[10];
+  Put2(tmp, x / 100000000);
+  Put8(tmp + 2, x % 100000000);
+  memcpy(buf, tmp + 10 - len, len);
+}
+
+static const int OutBufSize = 4096; // буфер вывода на стеке
+
 ostream& operator<<(ostream &ostr, const TSet &s) // вывод
 {
-    return ostr;
+  // элементы извлекаются из слов поля и записываются в буфер, который
+  // передается потоку одним вызовом write при заполнении
+  const TBitField &bf = s.BitField;
+  const int bitsInElem = sizeof(TELEM) * 8;
+  char buf[OutBufSize];
+  int len = 0, first = 1;
+  int digits = 1;               // к-во цифр текущего элемента; элементы
+  unsigned long long next = 10; // возрастают, поэтому оно только растет
+  buf[len++] = '{';
+  for (int i = 0; i < bf.MemLen; i++)
+    for (TELEM w = bf.pMem[i]; w != 0; w &= w - 1)
+    {
+      if (len > OutBufSize - 16) // место для ", ", 10 цифр и '}'
+      {
+        ostr.write(buf, len);
+        len = 0;
+      }
+      if (!first)
+      {
+        buf[len++] = ',';
+        buf[len++] = ' ';
+      }
+      first = 0;
+      unsigned int e = i * bitsInElem + BitLowest(w);
+      for (; e >= next; next *= 10)
+        digits++;
+      PutUInt(buf + len, e, digits);
+      len += digits;
+    }
+  buf[len++] = '}';
+  ostr.write(buf, len);
+  return ostr;
 }
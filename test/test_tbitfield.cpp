@@ -2,6 +2,10 @@
 
 #include <gtest.h>
 
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
 TEST(TBitField, can_create_bitfield_with_positive_length)
 {
   ASSERT_NO_THROW(TBitField bf(3));
@@ -309,3 +313,855 @@ TEST(TBitField, bitfields_with_different_bits_are_not_equal)
 
   EXPECT_NE(bf1, bf2);
 }
+
+TEST(TBitField, or_operator_applied_to_large_bitfields_of_non_equal_size)
+{
+  const int size1 = 1000, size2 = 2500;
+  TBitField bf1(size1), bf2(size2), expBf(size2);
+  for (int i = 0; i < size1; i += 3)
+  {
+    bf1.SetBit(i);
+    expBf.SetBit(i);
+  }
+  for (int i = 0; i < size2; i += 7)
+  {
+    bf2.SetBit(i);
+    expBf.SetBit(i);
+  }
+
+  EXPECT_EQ(expBf, bf1 | bf2);
+  EXPECT_EQ(expBf, bf2 | bf1);
+}
+
+TEST(TBitField, and_operator_applied_to_large_bitfields_of_non_equal_size)
+{
+  const int size1 = 1000, size2 = 2500;
+  TBitField bf1(size1), bf2(size2), expBf(size2);
+  for (int i = 0; i < size1; i += 3)
+    bf1.SetBit(i);
+  for (int i = 0; i < size2; i += 7)
+    bf2.SetBit(i);
+  for (int i = 0; i < size1; i += 21)
+    expBf.SetBit(i);
+
+  EXPECT_EQ(expBf, bf1 & bf2);
+  EXPECT_EQ(expBf, bf2 & bf1);
+}
+
+TEST(TBitField, can_invert_bitfield_longer_than_cache_line)
+{
+  const int size = 1027;
+  TBitField bf(size), expNegBf(size);
+  for (int i = 0; i < size; i += 5)
+    bf.SetBit(i);
+  for (int i = 0; i < size; i++)
+    if (i % 5 != 0)
+      expNegBf.SetBit(i);
+
+  EXPECT_EQ(expNegBf, ~bf);
+}
+
+TEST(TBitField, or_assign_operator_applied_to_bitfields_of_equal_size)
+{
+  const int size = 4;
+  TBitField bf1(size), bf2(size), expBf(size);
+  // bf1 = 0011
+  bf1.SetBit(2);
+  bf1.SetBit(3);
+  // bf2 = 0101
+  bf2.SetBit(1);
+  bf2.SetBit(3);
+  bf1 |= bf2;
+
+  // expBf = 0111
+  expBf.SetBit(1);
+  expBf.SetBit(2);
+  expBf.SetBit(3);
+
+  EXPECT_EQ(expBf, bf1);
+}
+
+TEST(TBitField, or_assign_operator_keeps_length_and_drops_extra_bits)
+{
+  const int size1 = 40, size2 = 70;
+  TBitField bf1(size1), bf2(size2), expBf(size1);
+  bf1.SetBit(1);
+  bf2.SetBit(39);
+  bf2.SetBit(45);
+  bf2.SetBit(69);
+  bf1 |= bf2;
+
+  expBf.SetBit(1);
+  expBf.SetBit(39);
+
+  EXPECT_EQ(size1, bf1.GetLength());
+  EXPECT_EQ(expBf, bf1);
+}
+
+TEST(TBitField, and_assign_operator_clears_bits_missing_in_shorter_operand)
+{
+  const int size1 = 70, size2 = 40;
+  TBitField bf1(size1), bf2(size2), expBf(size1);
+  bf1.SetBit(3);
+  bf1.SetBit(5);
+  bf1.SetBit(65);
+  bf2.SetBit(3);
+  bf1 &= bf2;
+
+  expBf.SetBit(3);
+
+  EXPECT_EQ(size1, bf1.GetLength());
+  EXPECT_EQ(expBf, bf1);
+}
+
+TEST(TBitField, xor_assign_operator_applied_to_bitfields_of_non_equal_size)
+{
+  const int size1 = 40, size2 = 70;
+  TBitField bf1(size1), bf2(size2), expBf(size1);
+  bf1.SetBit(1);
+  bf1.SetBit(2);
+  bf2.SetBit(2);
+  bf2.SetBit(38);
+  bf2.SetBit(60);
+  bf1 ^= bf2;
+
+  expBf.SetBit(1);
+  expBf.SetBit(38);
+
+  EXPECT_EQ(expBf, bf1);
+}
+
+TEST(TBitField, and_not_assign_operator_keeps_bits_missing_in_shorter_operand)
+{
+  const int size1 = 70, size2 = 40;
+  TBitField bf1(size1), bf2(size2), expBf(size1);
+  bf1.SetBit(3);
+  bf1.SetBit(5);
+  bf1.SetBit(65);
+  bf2.SetBit(3);
+  bf1 -= bf2;
+
+  expBf.SetBit(5);
+  expBf.SetBit(65);
+
+  EXPECT_EQ(expBf, bf1);
+}
+
+TEST(TBitField, can_move_bitfield)
+{
+  const int size = 40;
+  TBitField bf1(size);
+  bf1.SetBit(35);
+  TBitField bf2(std::move(bf1));
+
+  EXPECT_EQ(size, bf2.GetLength());
+  EXPECT_NE(0, bf2.GetBit(35));
+}
+
+TEST(TBitField, can_move_assign_bitfields_of_non_equal_size)
+{
+  const int size1 = 40, size2 = 5;
+  TBitField bf1(size1), bf2(size2);
+  bf1.SetBit(35);
+  bf2 = std::move(bf1);
+
+  EXPECT_EQ(size1, bf2.GetLength());
+  EXPECT_NE(0, bf2.GetBit(35));
+}
+
+TEST(TBitField, or_operator_applied_to_temporary_shorter_operand)
+{
+  const int size1 = 4, size2 = 40;
+  TBitField bf1(size1), bf2(size2), expBf(size2);
+  bf1.SetBit(2);
+  bf2.SetBit(35);
+  expBf.SetBit(2);
+  expBf.SetBit(35);
+
+  EXPECT_EQ(expBf, TBitField(bf1) | bf2);
+  EXPECT_EQ(expBf, bf2 | TBitField(bf1));
+  EXPECT_EQ(expBf, TBitField(bf1) | TBitField(bf2));
+}
+
+TEST(TBitField, chained_operators_on_temporaries)
+{
+  const int size = 38;
+  TBitField bf1(size), bf2(size), bf3(size), expBf(size);
+  bf1.SetBit(1);
+  bf2.SetBit(2);
+  bf3.SetBit(2);
+  bf3.SetBit(37);
+  // ~((bf1 | bf2) & bf3) = все биты, кроме 2
+  for (int i = 0; i < size; i++)
+    expBf.SetBit(i);
+  expBf.ClrBit(2);
+
+  EXPECT_EQ(expBf, ~((bf1 | bf2) & bf3));
+}
+
+TEST(TBitField, new_bitfield_has_zero_count)
+{
+  TBitField bf(100);
+
+  EXPECT_EQ(0, bf.Count());
+}
+
+TEST(TBitField, can_count_set_bits_of_large_bitfield)
+{
+  const int size = 10000;
+  TBitField bf(size);
+  int expCount = 0;
+  for (int i = 0; i < size; i += 3)
+  {
+    bf.SetBit(i);
+    expCount++;
+  }
+
+  EXPECT_EQ(expCount, bf.Count());
+  EXPECT_EQ(size - expCount, (~bf).Count());
+}
+
+TEST(TBitField, can_count_set_bits_in_range)
+{
+  const int size = 200;
+  TBitField bf(size);
+  for (int i = 0; i < size; i++)
+    bf.SetBit(i);
+
+  EXPECT_EQ(0, bf.CountRange(5, 5));
+  EXPECT_EQ(3, bf.CountRange(5, 8));
+  EXPECT_EQ(32, bf.CountRange(0, 32));
+  EXPECT_EQ(130, bf.CountRange(31, 161));
+  EXPECT_EQ(size, bf.CountRange(0, size));
+}
+
+TEST(TBitField, throws_when_count_range_is_out_of_bounds)
+{
+  TBitField bf(10);
+
+  ASSERT_ANY_THROW(bf.CountRange(-1, 5));
+  ASSERT_ANY_THROW(bf.CountRange(5, 11));
+  ASSERT_ANY_THROW(bf.CountRange(6, 5));
+}
+
+TEST(TBitField, range_operations_match_bit_by_bit_operations)
+{
+  const int size = 300;
+  const int ranges[][2] = { { 0, 0 }, { 3, 9 }, { 0, 32 }, { 31, 161 }, { 64, 128 }, { 250, 300 } };
+  for (const auto &r : ranges)
+  {
+    TBitField bf(size), exp(size);
+    for (int i = 0; i < size; i += 5)
+    {
+      bf.SetBit(i);
+      exp.SetBit(i);
+    }
+
+    bf.SetRange(r[0], r[1]);
+    for (int i = r[0]; i < r[1]; i++)
+      exp.SetBit(i);
+    EXPECT_EQ(exp, bf);
+    EXPECT_TRUE(bf.AllInRange(r[0], r[1]));
+
+    bf.FlipRange(r[0], r[1]);
+    for (int i = r[0]; i < r[1]; i++)
+      exp.ClrBit(i);
+    EXPECT_EQ(exp, bf);
+    EXPECT_FALSE(bf.AnyInRange(r[0], r[1]));
+
+    bf.FlipRange(r[0], r[1]);
+    bf.ClrRange(r[0], r[1]);
+    EXPECT_EQ(exp, bf);
+  }
+}
+
+TEST(TBitField, range_queries_see_single_bits)
+{
+  TBitField bf(200);
+  bf.SetRange(10, 190);
+  bf.ClrBit(100);
+
+  EXPECT_FALSE(bf.AllInRange(10, 190));
+  EXPECT_TRUE(bf.AllInRange(101, 190));
+  EXPECT_TRUE(bf.AnyInRange(0, 11));
+  EXPECT_FALSE(bf.AnyInRange(0, 10));
+  EXPECT_FALSE(bf.AnyInRange(100, 101));
+  EXPECT_EQ(0, bf.GetBit(190));
+}
+
+TEST(TBitField, extract_copies_range_of_bits)
+{
+  const int size = 300;
+  TBitField bf(size);
+  for (int i = 0; i < size; i += 3)
+    bf.SetBit(i);
+  const int ranges[][2] = { { 0, 0 }, { 0, 300 }, { 5, 6 }, { 31, 161 }, { 64, 96 }, { 250, 300 } };
+  for (const auto &r : ranges)
+  {
+    TBitField res = bf.Extract(r[0], r[1]);
+
+    ASSERT_EQ(r[1] - r[0], res.GetLength());
+    for (int i = 0; i < res.GetLength(); i++)
+      EXPECT_EQ(bf.GetBit(r[0] + i), res.GetBit(i));
+    EXPECT_EQ(bf.CountRange(r[0], r[1]), res.Count());
+  }
+  ASSERT_ANY_THROW(bf.Extract(10, 301));
+}
+
+TEST(TBitField, throws_when_range_is_out_of_bounds)
+{
+  TBitField bf(10);
+
+  ASSERT_ANY_THROW(bf.SetRange(-1, 5));
+  ASSERT_ANY_THROW(bf.ClrRange(5, 11));
+  ASSERT_ANY_THROW(bf.FlipRange(6, 5));
+  ASSERT_ANY_THROW(bf.AllInRange(0, 11));
+  ASSERT_ANY_THROW(bf.AnyInRange(-1, 0));
+}
+
+TEST(TBitField, find_returns_minus_one_for_empty_bitfield)
+{
+  TBitField bf(100);
+
+  EXPECT_EQ(-1, bf.FindFirst());
+  EXPECT_EQ(-1, bf.FindLast());
+  EXPECT_EQ(-1, bf.FindNext(10));
+  EXPECT_EQ(-1, bf.FindPrev(10));
+}
+
+TEST(TBitField, can_find_set_bits)
+{
+  const int size = 200;
+  TBitField bf(size);
+  bf.SetBit(3);
+  bf.SetBit(31);
+  bf.SetBit(32);
+  bf.SetBit(150);
+
+  EXPECT_EQ(3, bf.FindFirst());
+  EXPECT_EQ(150, bf.FindLast());
+  EXPECT_EQ(31, bf.FindNext(3));
+  EXPECT_EQ(32, bf.FindNext(31));
+  EXPECT_EQ(150, bf.FindNext(32));
+  EXPECT_EQ(-1, bf.FindNext(150));
+  EXPECT_EQ(32, bf.FindPrev(150));
+  EXPECT_EQ(31, bf.FindPrev(32));
+  EXPECT_EQ(-1, bf.FindPrev(3));
+  EXPECT_EQ(150, bf.FindPrev(size));
+}
+
+TEST(TBitField, throws_when_find_next_with_too_large_index)
+{
+  TBitField bf(10);
+
+  ASSERT_ANY_THROW(bf.FindNext(10));
+  ASSERT_ANY_THROW(bf.FindPrev(11));
+}
+
+TEST(TBitField, can_iterate_over_set_bits)
+{
+  const int size = 100;
+  TBitField bf(size);
+  std::vector<int> bits;
+  bits.push_back(0);
+  bits.push_back(33);
+  bits.push_back(64);
+  bits.push_back(99);
+  for (unsigned int i = 0; i < bits.size(); i++)
+    bf.SetBit(bits[i]);
+
+  std::vector<int> res;
+  for (int n : bf)
+    res.push_back(n);
+
+  EXPECT_EQ(bits, res);
+}
+
+TEST(TBitField64, can_set_and_get_bits_across_word_boundary)
+{
+  TBitField64 bf(200);
+
+  bf.SetBit(63);
+  bf.SetBit(64);
+  bf.SetBit(199);
+  bf.ClrBit(64);
+
+  EXPECT_NE(0, bf.GetBit(63));
+  EXPECT_EQ(0, bf.GetBit(64));
+  EXPECT_NE(0, bf.GetBit(199));
+  EXPECT_EQ(2, bf.Count());
+}
+
+TEST(TBitField64, operations_match_32_bit_bitfield)
+{
+  const int size1 = 300, size2 = 177;
+  TBitField a(size1), b(size2);
+  TBitField64 a64(size1), b64(size2);
+  for (int i = 0; i < size1; i += 7)
+  {
+    a.SetBit(i);
+    a64.SetBit(i);
+  }
+  for (int i = 0; i < size2; i += 5)
+  {
+    b.SetBit(i);
+    b64.SetBit(i);
+  }
+  TBitField r1 = a | b, r2 = a & b, r3 = ~a;
+  TBitField64 s1 = a64 | b64, s2 = a64 & b64, s3 = ~a64;
+
+  for (int i = 0; i < size1; i++)
+  {
+    EXPECT_EQ(r1.GetBit(i), s1.GetBit(i));
+    EXPECT_EQ(r2.GetBit(i), s2.GetBit(i));
+    EXPECT_EQ(r3.GetBit(i), s3.GetBit(i));
+  }
+  EXPECT_EQ(r3.Count(), s3.Count());
+  EXPECT_EQ(r1.FindLast(), s1.FindLast());
+}
+
+#ifdef __SIZEOF_INT128__
+TEST(TBitField128, can_find_and_count_bits_in_wide_words)
+{
+  TBitField128 bf(300);
+
+  bf.SetBit(5);
+  bf.SetBit(127);
+  bf.SetBit(128);
+  bf.SetBit(290);
+
+  EXPECT_EQ(4, bf.Count());
+  EXPECT_EQ(2, bf.CountRange(100, 200));
+  EXPECT_EQ(5, bf.FindFirst());
+  EXPECT_EQ(127, bf.FindNext(5));
+  EXPECT_EQ(128, bf.FindPrev(290));
+  EXPECT_EQ(290, bf.FindLast());
+}
+
+TEST(TBitField128, negation_keeps_tail_bits_clear)
+{
+  TBitField128 bf(130), expNegBf(130);
+  bf.SetBit(1);
+  for (int i = 0; i < 130; i++)
+    if (i != 1)
+      expNegBf.SetBit(i);
+
+  EXPECT_EQ(expNegBf, ~bf);
+  EXPECT_EQ(129, (~bf).Count());
+}
+#endif
+
+TEST(TBitField, move_of_short_bitfield_keeps_bits)
+{
+  TBitField bf(100);
+  bf.SetBit(5);
+  bf.SetBit(99);
+
+  TBitField res(std::move(bf));
+
+  EXPECT_EQ(100, res.GetLength());
+  EXPECT_EQ(2, res.Count());
+  EXPECT_NE(0, res.GetBit(99));
+  EXPECT_EQ(0, bf.GetLength());
+}
+
+TEST(TBitField, can_assign_between_short_and_long_bitfields)
+{
+  TBitField sh(10), lng(1000);
+  sh.SetBit(3);
+  lng.SetBit(999);
+  TBitField a(sh), b(lng);
+
+  a = lng;
+  b = sh;
+
+  EXPECT_EQ(lng, a);
+  EXPECT_EQ(sh, b);
+
+  a = std::move(b);
+  b = TBitField(lng);
+
+  EXPECT_EQ(sh, a);
+  EXPECT_EQ(lng, b);
+}
+
+// ресурс памяти, считающий выделенные байты
+class TCountingResource : public std::pmr::memory_resource
+{
+public:
+  long long Bytes = 0;
+private:
+  void *do_allocate(size_t bytes, size_t align) override
+  {
+    Bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t align) override
+  {
+    Bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &r) const noexcept override
+  {
+    return this == &r;
+  }
+};
+
+TEST(TBitField, takes_memory_of_long_bitfields_from_given_resource)
+{
+  TCountingResource res;
+  {
+    TBitField a(1000, &res), b(1000, &res), sh(100, &res);
+    a.SetBit(1);
+    b.SetBit(2);
+    TBitField c = ~(a | b) & a;
+
+    EXPECT_EQ(&res, c.GetResource());
+    EXPECT_EQ(3 * 32 * sizeof(TELEM), res.Bytes); // память sh - встроенная
+  }
+  EXPECT_EQ(0, res.Bytes);
+}
+
+TEST(TBitField, move_between_resources_copies_bits)
+{
+  TCountingResource res1, res2;
+  TBitField a(1000, &res1), b(1000, &res2);
+  a.SetBit(999);
+
+  b = std::move(a);
+
+  EXPECT_EQ(&res2, b.GetResource());
+  EXPECT_NE(0, b.GetBit(999));
+  EXPECT_EQ(32 * sizeof(TELEM), res2.Bytes);
+}
+
+TEST(TBitField, fused_expression_matches_step_by_step_evaluation)
+{
+  const int size1 = 200, size2 = 333, size3 = 70;
+  TBitField a(size1), b(size2), c(size3), d(size2);
+  for (int i = 0; i < size1; i += 3)
+    a.SetBit(i);
+  for (int i = 0; i < size2; i += 5)
+    b.SetBit(i);
+  for (int i = 0; i < size3; i += 2)
+    c.SetBit(i);
+  for (int i = 0; i < size2; i += 7)
+    d.SetBit(i);
+  TBitField t1 = a | b;
+  TBitField t2 = ~c;
+  TBitField t3 = t1 & t2;
+  TBitField t4 = ~t3;
+  TBitField expBf = t4 | d;
+
+  TBitField bf = ~((a.Lazy() | b) & ~c.Lazy()) | d;
+
+  EXPECT_EQ(expBf, bf);
+  EXPECT_EQ(expBf.Count(), (~((a.Lazy() | b) & ~c.Lazy()) | d).Count());
+  EXPECT_EQ(expBf.GetBit(100), (~((a.Lazy() | b) & ~c.Lazy()) | d).GetBit(100));
+}
+
+TEST(TBitField, operations_on_constant_operands_return_fields)
+{
+  TBitField a(10), b(20);
+  a.SetBit(1);
+  b.SetBit(2);
+
+  EXPECT_TRUE((is_same<decltype(a | b), TBitField>::value));
+  EXPECT_TRUE((is_same<decltype(a & b), TBitField>::value));
+  EXPECT_TRUE((is_same<decltype(~a), TBitField>::value));
+  TBitField c = (a | b) | TBitField(5); // временный результат принимается как TBitField&&
+  c.SetBit(3);
+  EXPECT_EQ(20, c.GetLength());
+  EXPECT_EQ(3, c.Count());
+}
+
+TEST(TBitField, can_assign_expression_containing_left_operand)
+{
+  TBitField a(100), b(100), c(300);
+  a.SetBit(1);
+  b.SetBit(2);
+  c.SetBit(299);
+  TBitField expBf(100);
+  expBf.SetBit(1);
+  expBf.SetBit(2);
+
+  a = a.Lazy() | b;
+  EXPECT_EQ(expBf, a);
+
+  a = ~a.Lazy() & ~a.Lazy();
+  EXPECT_EQ(98, a.Count());
+
+  a = a.Lazy() | c; // длина результата меняется
+  EXPECT_EQ(300, a.GetLength());
+  EXPECT_EQ(99, a.Count());
+}
+
+TEST(TBitField, union_and_intersection_of_many_match_pairwise)
+{
+  const int k = 5;
+  const int sizes[k] = { 100000, 70001, 100000, 3, 99999 };
+  std::vector<TBitField> bfs;
+  for (int j = 0; j < k; j++)
+  {
+    TBitField bf(sizes[j]);
+    for (int i = j % 2; i < sizes[j]; i += j + 1)
+      bf.SetBit(i);
+    bfs.push_back(std::move(bf));
+  }
+  const TBitField *f[k];
+  for (int j = 0; j < k; j++)
+    f[j] = &bfs[j];
+  TBitField expOr(bfs[0]), expAnd(bfs[0]);
+  for (int j = 1; j < k; j++)
+  {
+    expOr = expOr | bfs[j];
+    expAnd = expAnd & bfs[j];
+  }
+
+  EXPECT_EQ(expOr, TBitField::UnionAll(f, k));
+  EXPECT_EQ(expAnd, TBitField::IntersectAll(f, k));
+  EXPECT_EQ(bfs[1] & bfs[2], TBitField::IntersectAll(f + 1, 2));
+  EXPECT_EQ(0, TBitField::UnionAll(f, 0).GetLength());
+}
+
+// восстанавливает настройки параллельного выполнения и при провале проверки
+class TParallelGuard
+{
+private:
+  int Threads;
+  size_t Bytes;
+public:
+  TParallelGuard() : Threads(BitOpsGetThreads()), Bytes(BitOpsGetParallelBytes()) {}
+  ~TParallelGuard()
+  {
+    BitOpsSetThreads(Threads);
+    BitOpsSetParallelBytes(Bytes);
+  }
+};
+
+TEST(TBitField, parallel_operations_match_serial)
+{
+  const int size = 100003;
+  TBitField a(size), b(size / 2);
+  for (int i = 0; i < size; i += 3)
+    a.SetBit(i);
+  for (int i = 1; i < size / 2; i += 5)
+    b.SetBit(i);
+  TBitField expOr = a | b, expAnd = a & b, expNot = ~a, expExpr = (a | b) & ~a;
+  int count = a.Count();
+
+  TParallelGuard guard;
+  BitOpsSetThreads(4);
+  BitOpsSetParallelBytes(0);
+  TBitField c(a), big(size);
+  EXPECT_EQ(0, big.Count());
+  EXPECT_TRUE(c == a);
+  EXPECT_EQ(expOr, TBitField(a | b));
+  EXPECT_EQ(expAnd, TBitField(a & b));
+  EXPECT_EQ(expNot, TBitField(~a));
+  EXPECT_EQ(expExpr, TBitField((a.Lazy() | b) & ~a.Lazy()));
+  EXPECT_EQ(expNot, ~TBitField(a));
+  EXPECT_EQ(count, a.Count());
+  c.ClrBit(size - 1);
+  c.SetBit(size - 2);
+  EXPECT_FALSE(c == a);
+}
+
+TEST(TBitField, output_writes_bits_starting_from_zero)
+{
+  const int size = 10007; // несколько буферов вывода, неполное последнее слово
+  TBitField bf(size);
+  std::string exp(size, '0');
+  for (int i = 0; i < size; i += 3)
+  {
+    bf.SetBit(i);
+    exp[i] = '1';
+  }
+  std::ostringstream os, os64;
+  TBitField64 bf64(size);
+  for (int i = 0; i < size; i += 3)
+    bf64.SetBit(i);
+
+  os << bf;
+  os64 << bf64;
+
+  EXPECT_EQ(exp, os.str());
+  EXPECT_EQ(exp, os64.str());
+}
+
+TEST(TBitField, input_reads_bits_until_other_character)
+{
+  const int size = 100;
+  std::string str = "  ";
+  for (int i = 0; i < 70; i++)
+    str += (i % 3 == 0) ? '1' : '0';
+  str += "2rest";
+  std::istringstream is(str);
+  TBitField bf(size), exp(size);
+  bf.SetBit(99);
+  for (int i = 0; i < 70; i += 3)
+    exp.SetBit(i);
+
+  is >> bf;
+
+  EXPECT_EQ(exp, bf);
+  EXPECT_EQ('2', is.peek());
+}
+
+TEST(TBitField, input_stops_after_length_bits)
+{
+  std::istringstream is("1111111");
+  TBitField bf(5), exp(5);
+  for (int i = 0; i < 5; i++)
+    exp.SetBit(i);
+
+  is >> bf;
+
+  EXPECT_EQ(exp, bf);
+  EXPECT_EQ('1', is.get());
+}
+
+TEST(TBitField, input_of_output_restores_bitfield)
+{
+  const int size = 100003;
+  TBitField bf(size), res(size);
+  for (int i = 0; i < size; i += 7)
+    bf.SetBit(i);
+  std::stringstream ss;
+
+  ss << bf;
+  ss >> res;
+
+  EXPECT_EQ(bf, res);
+}
+
+TEST(TBitField, load_of_saved_stream_restores_bitfield_and_length)
+{
+  const int size = 100003;
+  TBitField bf(size), res(5);
+  for (int i = 0; i < size; i += 7)
+    bf.SetBit(i);
+  std::stringstream ss;
+
+  bf.Save(ss);
+  res.Load(ss);
+
+  EXPECT_EQ(bf.SaveSize(), ss.str().size());
+  EXPECT_EQ(bf, res);
+}
+
+TEST(TBitField, load_of_saved_buffer_restores_bitfield)
+{
+  TBitField bf(1000), res(1);
+  for (int i = 3; i < 1000; i += 11)
+    bf.SetBit(i);
+  std::vector<char> buf(bf.SaveSize());
+
+  EXPECT_EQ(buf.size(), bf.Save(buf.data(), buf.size()));
+  EXPECT_EQ(buf.size(), res.Load(buf.data(), buf.size()));
+  EXPECT_EQ(bf, res);
+}
+
+TEST(TBitField, binary_format_does_not_depend_on_word_type)
+{
+  TBitField64 bf(333);
+  for (int i = 0; i < 333; i += 5)
+    bf.SetBit(i);
+  std::stringstream ss;
+  TBitField res(1);
+
+  bf.Save(ss);
+  res.Load(ss);
+
+  ASSERT_EQ(333, res.GetLength());
+  for (int i = 0; i < 333; i++)
+    EXPECT_EQ(bf.GetBit(i), res.GetBit(i));
+}
+
+TEST(TBitField, throws_when_loading_corrupted_data)
+{
+  TBitField bf(200), res(1), old(1);
+  bf.SetBit(100);
+  res.SetBit(0);
+  old.SetBit(0);
+  std::vector<char> buf(bf.SaveSize());
+  bf.Save(buf.data(), buf.size());
+  std::vector<char> bad = buf;
+  bad[24 + 12] ^= 1;
+
+  ASSERT_ANY_THROW(res.Load(bad.data(), bad.size()));
+  bad = buf;
+  bad[0] = 'X';
+  ASSERT_ANY_THROW(res.Load(bad.data(), bad.size()));
+  ASSERT_ANY_THROW(res.Load(buf.data(), buf.size() - 1));
+  std::istringstream is(std::string(buf.data(), buf.size() - 1));
+  ASSERT_ANY_THROW(res.Load(is));
+  EXPECT_EQ(old, res); // поле не изменилось
+}
+
+TEST(TBitField, throws_when_saving_to_too_small_buffer)
+{
+  TBitField bf(200);
+  std::vector<char> buf(bf.SaveSize() - 1);
+
+  ASSERT_ANY_THROW(bf.Save(buf.data(), buf.size()));
+}
+
+template <class TField>
+static TField ShiftSample(int len)
+{
+  TField bf(len);
+  for (int i = 0; i < len; i++)
+    if ((i * 7) % 5 < 2)
+      bf.SetBit(i);
+  return bf;
+}
+
+TEST(TBitField, shifts_move_bits_towards_higher_and_lower_numbers)
+{
+  const int lens[] = { 1, 31, 32, 100, 257 };
+  const int shifts[] = { 0, 1, 5, 31, 32, 33, 64, 99, 300 };
+  for (int len : lens)
+    for (int k : shifts)
+    {
+      TBitField bf = ShiftSample<TBitField>(len);
+      TBitField left = bf << k, right = bf >> k;
+      for (int i = 0; i < len; i++)
+      {
+        EXPECT_EQ((i >= k) ? bf.GetBit(i - k) : 0, left.GetBit(i));
+        EXPECT_EQ((i + k < len) ? bf.GetBit(i + k) : 0, right.GetBit(i));
+      }
+      EXPECT_EQ(left, TBitField(bf).ShiftLeft(k));
+      EXPECT_EQ(right, TBitField(bf) >>= k);
+      EXPECT_EQ(left.Count(), left.CountRange(0, len));
+    }
+}
+
+TEST(TBitField, rotations_move_bits_cyclically)
+{
+  const int lens[] = { 1, 31, 64, 100, 257 };
+  const int shifts[] = { 0, 1, 31, 64, 99, 300 };
+  for (int len : lens)
+    for (int k : shifts)
+    {
+      TBitField64 bf = ShiftSample<TBitField64>(len);
+      TBitField64 left(bf), right(bf);
+      left.RotateLeft(k);
+      right.RotateRight(k);
+      for (int i = 0; i < len; i++)
+      {
+        EXPECT_EQ(bf.GetBit(i), left.GetBit((i + k) % len));
+        EXPECT_EQ(bf.GetBit((i + k) % len), right.GetBit(i));
+      }
+      EXPECT_EQ(bf.Count(), left.Count());
+    }
+}
+
+TEST(TBitField, throws_when_shift_is_negative)
+{
+  TBitField bf(10);
+
+  ASSERT_ANY_THROW(bf << -1);
+  ASSERT_ANY_THROW(bf.ShiftRight(-1));
+  ASSERT_ANY_THROW(bf.RotateLeft(-1));
+}
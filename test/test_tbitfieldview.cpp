@@ -0,0 +1,102 @@
+#include "tbitfieldview.h"
+
+#include <gtest.h>
+
+#include <vector>
+
+static TBitField ViewSample(int len)
+{
+  TBitField bf(len);
+  for (int i = 0; i < len; i++)
+    if ((i * 7) % 5 < 2)
+      bf.SetBit(i);
+  return bf;
+}
+
+TEST(TBitFieldView, view_reads_bits_of_range)
+{
+  TBitField bf = ViewSample(300);
+  TBitFieldView v(bf, 37, 250);
+
+  ASSERT_EQ(213, v.GetLength());
+  for (int i = 0; i < v.GetLength(); i++)
+    EXPECT_EQ(bf.GetBit(37 + i), v.GetBit(i));
+  EXPECT_EQ(bf.CountRange(37, 250), v.Count());
+  ASSERT_ANY_THROW(v.GetBit(213));
+}
+
+TEST(TBitFieldView, view_sees_changes_of_field)
+{
+  TBitField bf(100);
+  TBitFieldView v(bf, 10, 20);
+
+  bf.SetBit(15);
+
+  EXPECT_EQ(1, v.GetBit(5));
+  EXPECT_EQ(5, v.FindFirst());
+}
+
+TEST(TBitFieldView, find_and_iteration_stay_inside_range)
+{
+  TBitField bf(200);
+  bf.SetBit(5);
+  bf.SetBit(50);
+  bf.SetBit(60);
+  bf.SetBit(150);
+  TBitFieldView v(bf, 40, 100), empty(bf, 70, 140);
+  std::vector<int> bits;
+
+  for (int n : v)
+    bits.push_back(n);
+
+  EXPECT_EQ(std::vector<int>({ 10, 20 }), bits);
+  EXPECT_EQ(20, v.FindLast());
+  EXPECT_EQ(10, v.FindPrev(20));
+  EXPECT_EQ(-1, empty.FindFirst());
+  EXPECT_EQ(-1, empty.FindLast());
+}
+
+TEST(TBitFieldView, subview_and_extract_copy_same_bits)
+{
+  TBitField bf = ViewSample(500);
+  TBitFieldView v(bf, 3, 480);
+  TBitFieldView sub(v, 70, 300);
+
+  TBitField copy = sub.Extract();
+
+  EXPECT_EQ(bf.Extract(73, 303), copy);
+  EXPECT_TRUE(sub == TBitFieldView(copy));
+}
+
+TEST(TBitFieldView, logical_operations_match_extracted_fields)
+{
+  TBitField a = ViewSample(400), b(150);
+  for (int i = 0; i < 150; i += 3)
+    b.SetBit(i);
+  TBitFieldView va(a, 13, 213), vb(a, 100, 350);
+  TBitField ea = va.Extract(), eb = vb.Extract();
+
+  EXPECT_EQ(TBitField(ea | eb), va | vb);
+  EXPECT_EQ(TBitField(ea & eb), va & vb);
+  EXPECT_EQ(TBitField(ea | b), va | b);
+  EXPECT_EQ(TBitField(b & ea), b & va);
+  EXPECT_EQ(TBitField(~ea), ~va);
+  TBitField x = ea;
+  x ^= eb;
+  TBitField exp(250);
+  exp |= x;
+  for (int i = 200; i < 250; i++)
+    if (eb.GetBit(i))
+      exp.SetBit(i);
+  EXPECT_EQ(exp, va ^ vb);
+}
+
+TEST(TBitFieldView, throws_when_range_is_out_of_field)
+{
+  TBitField bf(10);
+
+  ASSERT_ANY_THROW(TBitFieldView v(bf, -1, 5));
+  ASSERT_ANY_THROW(TBitFieldView v(bf, 5, 11));
+  TBitFieldView v(bf, 2, 8);
+  ASSERT_ANY_THROW(TBitFieldView s(v, 0, 7));
+}
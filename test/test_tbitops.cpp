@@ -0,0 +1,101 @@
+#include "tbitops.h"
+
+#include <gtest.h>
+
+#include <vector>
+
+// восстанавливает набор инструкций по выходе из теста, в т.ч. при ошибке
+class TIsaGuard
+{
+private:
+  TBitOpsIsa Saved;
+public:
+  TIsaGuard() : Saved(BitOpsGetIsa()) {}
+  ~TIsaGuard() { BitOpsSetIsa(Saved); }
+};
+
+static const TBitOpsIsa AllIsa[] = { BITOPS_SCALAR, BITOPS_SSE2, BITOPS_AVX2, BITOPS_AVX512 };
+
+// нечетные длины задевают векторную часть и скалярный хвост ядер
+static const size_t Lengths[] = { 0, 1, 7, 15, 31, 33, 63, 65, 127, 257, 1023, 4099 };
+
+static std::vector<unsigned char> Pattern(size_t n, unsigned seed)
+{
+  std::vector<unsigned char> v(n + 1); // +1 - для невыровненного начала
+  for (size_t i = 0; i < v.size(); i++)
+  {
+    seed = seed * 1103515245u + 12345u;
+    v[i] = (unsigned char)(seed >> 16);
+  }
+  return v;
+}
+
+static long long CountRef(const unsigned char *a, size_t n)
+{
+  long long c = 0;
+  for (size_t i = 0; i < n; i++)
+    for (int j = 0; j < 8; j++)
+      c += (a[i] >> j) & 1;
+  return c;
+}
+
+TEST(TBitOps, scalar_isa_is_always_supported)
+{
+  TIsaGuard guard;
+
+  EXPECT_EQ(1, BitOpsSetIsa(BITOPS_SCALAR));
+  EXPECT_EQ(BITOPS_SCALAR, BitOpsGetIsa());
+}
+
+TEST(TBitOps, kernels_of_every_supported_isa_match_reference)
+{
+  TIsaGuard guard;
+  for (TBitOpsIsa isa : AllIsa)
+  {
+    if (!BitOpsSetIsa(isa))
+      continue;
+    SCOPED_TRACE(BitOpsIsaName(isa));
+    for (size_t n : Lengths)
+      for (size_t off = 0; off < 2; off++)
+      {
+        std::vector<unsigned char> va = Pattern(n, 1), vb = Pattern(n, 2), vd(n + 1);
+        const unsigned char *a = va.data() + off, *b = vb.data() + off;
+        unsigned char *d = vd.data() + off;
+
+        BitOrBytes(d, a, b, n);
+        for (size_t i = 0; i < n; i++)
+          ASSERT_EQ((unsigned char)(a[i] | b[i]), d[i]) << "or, n = " << n;
+        BitAndBytes(d, a, b, n);
+        for (size_t i = 0; i < n; i++)
+          ASSERT_EQ((unsigned char)(a[i] & b[i]), d[i]) << "and, n = " << n;
+        BitXorBytes(d, a, b, n);
+        for (size_t i = 0; i < n; i++)
+          ASSERT_EQ((unsigned char)(a[i] ^ b[i]), d[i]) << "xor, n = " << n;
+        BitAndNotBytes(d, a, b, n);
+        for (size_t i = 0; i < n; i++)
+          ASSERT_EQ((unsigned char)(a[i] & ~b[i]), d[i]) << "andnot, n = " << n;
+        BitNotBytes(d, a, n);
+        for (size_t i = 0; i < n; i++)
+          ASSERT_EQ((unsigned char)~a[i], d[i]) << "not, n = " << n;
+        EXPECT_EQ(CountRef(a, n), BitCountBytes(a, n)) << "count, n = " << n;
+      }
+  }
+}
+
+TEST(TBitOps, kernels_work_in_place)
+{
+  TIsaGuard guard;
+  for (TBitOpsIsa isa : AllIsa)
+  {
+    if (!BitOpsSetIsa(isa))
+      continue;
+    SCOPED_TRACE(BitOpsIsaName(isa));
+    std::vector<unsigned char> a = Pattern(1001, 3), b = Pattern(1001, 4), exp(a);
+    for (size_t i = 0; i < exp.size(); i++)
+      exp[i] |= b[i];
+
+    BitOrBytes(a.data(), a.data(), b.data(), a.size());
+
+    EXPECT_EQ(exp, a);
+  }
+}
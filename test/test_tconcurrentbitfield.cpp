@@ -0,0 +1,79 @@
+#include "tconcurrentbitfield.h"
+
+#include <gtest.h>
+
+#include <thread>
+
+TEST(TConcurrentBitField, new_bitfield_is_set_to_zero)
+{
+  TConcurrentBitField bf(100);
+
+  EXPECT_EQ(100, bf.GetLength());
+  EXPECT_EQ(0, bf.Count());
+  EXPECT_EQ(TBitField(100), bf.Snapshot());
+}
+
+TEST(TConcurrentBitField, throws_when_create_bitfield_with_negative_length)
+{
+  ASSERT_ANY_THROW(TConcurrentBitField bf(-3));
+}
+
+TEST(TConcurrentBitField, throws_when_access_bit_out_of_range)
+{
+  TConcurrentBitField bf(10);
+
+  ASSERT_ANY_THROW(bf.SetBit(10));
+  ASSERT_ANY_THROW(bf.ClrBit(-1));
+  ASSERT_ANY_THROW(bf.TestAndSet(10));
+  ASSERT_ANY_THROW(bf.GetBit(-1));
+}
+
+TEST(TConcurrentBitField, test_and_set_returns_previous_value)
+{
+  TConcurrentBitField bf(40);
+
+  EXPECT_EQ(0, bf.TestAndSet(35));
+  EXPECT_EQ(1, bf.TestAndSet(35));
+  EXPECT_EQ(1, bf.GetBit(35));
+  EXPECT_EQ(1, bf.TestAndClear(35));
+  EXPECT_EQ(0, bf.TestAndClear(35));
+  EXPECT_EQ(0, bf.GetBit(35));
+}
+
+TEST(TConcurrentBitField, snapshot_matches_source_bitfield)
+{
+  const int size = 1000;
+  TBitField src(size);
+  for (int i = 0; i < size; i += 7)
+    src.SetBit(i);
+  TConcurrentBitField bf(src);
+  bf.SetBit(1);
+  bf.ClrBit(0);
+  src.SetBit(1);
+  src.ClrBit(0);
+
+  EXPECT_EQ(src, bf.Snapshot());
+  EXPECT_EQ(src.Count(), bf.Count());
+}
+
+TEST(TConcurrentBitField, each_bit_is_won_by_exactly_one_thread)
+{
+  const int size = 10000, threads = 8;
+  TConcurrentBitField bf(size);
+  int won[threads] = { 0 };
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; t++)
+    pool.push_back(std::thread([&bf, &won, t] {
+      // соседние биты одного слова захватываются разными потоками
+      for (int i = 0; i < size; i++)
+        won[t] += !bf.TestAndSet((i + t * 13) % size);
+    }));
+  for (int t = 0; t < threads; t++)
+    pool[t].join();
+
+  int total = 0;
+  for (int t = 0; t < threads; t++)
+    total += won[t];
+  EXPECT_EQ(size, total);
+  EXPECT_EQ(size, bf.Count());
+}
@@ -0,0 +1,107 @@
+#include "tewahbitfield.h"
+
+#include <gtest.h>
+
+TEST(TEwahBitField, new_bitfield_is_set_to_zero)
+{
+  TEwahBitField bf(1000);
+
+  EXPECT_EQ(1000, bf.GetLength());
+  EXPECT_EQ(0, bf.Count());
+  EXPECT_EQ(0, bf.GetBit(999));
+  EXPECT_EQ(1, bf.SizeInWords());
+}
+
+TEST(TEwahBitField, throws_when_create_bitfield_with_negative_length)
+{
+  ASSERT_ANY_THROW(TEwahBitField bf(-3));
+}
+
+TEST(TEwahBitField, throws_when_get_bit_with_too_large_index)
+{
+  TEwahBitField bf(10);
+
+  ASSERT_ANY_THROW(bf.GetBit(10));
+}
+
+TEST(TEwahBitField, can_compress_and_decompress_bitfield)
+{
+  const int size = 10000;
+  TBitField bf(size);
+  for (int i = 100; i < 5000; i++)
+    bf.SetBit(i);
+  for (int i = 6000; i < size; i += 7)
+    bf.SetBit(i);
+  TEwahBitField ebf(bf);
+
+  for (int i = 0; i < size; i++)
+    ASSERT_EQ(bf.GetBit(i), ebf.GetBit(i));
+  EXPECT_EQ(bf.Count(), ebf.Count());
+  EXPECT_EQ(bf, TBitField(ebf));
+}
+
+TEST(TEwahBitField, long_runs_are_compressed)
+{
+  const int size = 1000000;
+  TBitField bf(size);
+  for (int i = 0; i < size / 2; i++)
+    bf.SetBit(i);
+  bf.SetBit(size - 1);
+  TEwahBitField ebf(bf);
+
+  EXPECT_LT(ebf.SizeInWords(), 5);
+}
+
+TEST(TEwahBitField, or_operator_applied_to_bitfields_of_non_equal_size)
+{
+  const int size1 = 3000, size2 = 5000;
+  TBitField bf1(size1), bf2(size2);
+  for (int i = 0; i < 1000; i++)
+    bf1.SetBit(i);
+  for (int i = 500; i < size1; i += 3)
+    bf1.SetBit(i);
+  for (int i = 2000; i < 4500; i++)
+    bf2.SetBit(i);
+  bf2.SetBit(4999);
+
+  EXPECT_EQ(bf1 | bf2, TBitField(TEwahBitField(bf1) | TEwahBitField(bf2)));
+  EXPECT_EQ(bf2 | bf1, TBitField(TEwahBitField(bf2) | TEwahBitField(bf1)));
+}
+
+TEST(TEwahBitField, and_operator_applied_to_bitfields_of_non_equal_size)
+{
+  const int size1 = 3000, size2 = 5000;
+  TBitField bf1(size1), bf2(size2);
+  for (int i = 0; i < 1000; i++)
+    bf1.SetBit(i);
+  for (int i = 500; i < size1; i += 3)
+    bf1.SetBit(i);
+  for (int i = 0; i < size2; i += 2)
+    bf2.SetBit(i);
+
+  EXPECT_EQ(bf1 & bf2, TBitField(TEwahBitField(bf1) & TEwahBitField(bf2)));
+  EXPECT_EQ(bf2 & bf1, TBitField(TEwahBitField(bf2) & TEwahBitField(bf1)));
+}
+
+TEST(TEwahBitField, can_invert_bitfield)
+{
+  const int size = 1000;
+  TBitField bf(size);
+  for (int i = 0; i < 300; i++)
+    bf.SetBit(i);
+  bf.SetBit(777);
+  TEwahBitField neg = ~TEwahBitField(bf);
+
+  EXPECT_EQ(~bf, TBitField(neg));
+  EXPECT_EQ(size - 301, neg.Count());
+  EXPECT_EQ(TEwahBitField(bf), ~neg);
+}
+
+TEST(TEwahBitField, can_invert_empty_bitfield_of_whole_words)
+{
+  TEwahBitField bf(128);
+  TEwahBitField neg = ~bf;
+
+  EXPECT_EQ(128, neg.Count());
+  EXPECT_EQ(1, neg.SizeInWords());
+}
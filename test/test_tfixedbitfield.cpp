@@ -0,0 +1,72 @@
+#include "tfixedbitfield.h"
+
+#include <gtest.h>
+
+#include <sstream>
+
+static constexpr TFixedBitField<100> MakeField(int a, int b)
+{
+  TFixedBitField<100> bf;
+  bf.SetBit(a);
+  bf.SetBit(b);
+  return bf;
+}
+
+TEST(TFixedBitField, can_evaluate_operations_at_compile_time)
+{
+  constexpr TFixedBitField<100> empty;
+  constexpr TFixedBitField<100> bf = MakeField(3, 64);
+
+  static_assert(bf.GetBit(3) && bf.GetBit(64) && !bf.GetBit(4), "");
+  static_assert((bf & ~bf) == empty, "");
+  static_assert((bf | ~bf) == ~empty, "");
+  static_assert((bf | MakeField(5, 99)) == (MakeField(3, 5) | MakeField(64, 99)), "");
+  static_assert(TFixedBitField<100>::GetLength() == 100, "");
+  static_assert(bf.Count() == 2, "");
+  static_assert((~bf).Count() == 98, "");
+  EXPECT_EQ(2, bf.Count());
+}
+
+TEST(TFixedBitField, negation_keeps_tail_bits_clear)
+{
+  TFixedBitField<70> bf;
+  bf.SetBit(1);
+
+  EXPECT_EQ(69, (~bf).Count());
+  EXPECT_EQ(0, (~bf).GetBit(1));
+}
+
+TEST(TFixedBitField, throws_when_bit_index_is_out_of_range)
+{
+  TFixedBitField<10> bf;
+
+  ASSERT_ANY_THROW(bf.SetBit(10));
+  ASSERT_ANY_THROW(bf.GetBit(-1));
+}
+
+TEST(TFixedBitField, can_convert_to_and_from_bitfield)
+{
+  TBitField bf(130);
+  bf.SetBit(0);
+  bf.SetBit(65);
+  bf.SetBit(129);
+
+  TFixedBitField<100> fbf(bf); // бит 129 отбрасывается
+  TBitField res = fbf;
+
+  EXPECT_EQ(100, res.GetLength());
+  EXPECT_EQ(2, res.Count());
+  EXPECT_NE(0, res.GetBit(65));
+}
+
+TEST(TFixedBitField, can_output_in_bitfield_format)
+{
+  TFixedBitField<5> bf;
+  bf.SetBit(1);
+  bf.SetBit(4);
+  std::ostringstream os;
+
+  os << bf;
+
+  EXPECT_EQ("01001", os.str());
+}
@@ -0,0 +1,47 @@
+#include "tfixedset.h"
+
+#include <gtest.h>
+
+TEST(TFixedSet, can_evaluate_operations_at_compile_time)
+{
+  constexpr TFixedSet<256> s1 = TFixedSet<256>() + 1 + 200;
+  constexpr TFixedSet<256> s2 = TFixedSet<256>() + 200 + 255;
+
+  static_assert((s1 * s2).IsMember(200) && !(s1 * s2).IsMember(1), "");
+  static_assert((s1 + s2) == s1 + 255, "");
+  static_assert((~s1).IsMember(0) && !(~s1).IsMember(1), "");
+  static_assert((s1 - 1) != s1, "");
+  EXPECT_EQ(3, (s1 + s2).Cardinality());
+}
+
+TEST(TFixedSet, can_convert_to_and_from_set)
+{
+  TSet s(100);
+  s.InsElem(7);
+  s.InsElem(99);
+
+  TFixedSet<64> fs(s); // элемент 99 отбрасывается
+  TSet res = fs;
+
+  EXPECT_EQ(64, res.GetMaxPower());
+  EXPECT_EQ(1, res.Cardinality());
+  EXPECT_NE(0, res.IsMember(7));
+}
+
+TEST(TFixedSet, in_place_operations_match_binary_ones)
+{
+  TFixedSet<128> a, b;
+  a.InsElem(1);
+  a.InsElem(100);
+  b.InsElem(100);
+  b.InsElem(127);
+  TFixedSet<128> u = a, i = a, d = a;
+
+  u += b;
+  i *= b;
+  d -= b;
+
+  EXPECT_EQ(a + b, u);
+  EXPECT_EQ(a * b, i);
+  EXPECT_EQ(a * ~b, d);
+}
@@ -0,0 +1,102 @@
+#include "tmappedbitfield.h"
+
+#include <gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+static const char *MappedFile = "test_tmappedbitfield.tmp";
+
+static void SaveToFile(const TBitField &bf)
+{
+  std::ofstream os(MappedFile, std::ios::binary);
+  bf.Save(os);
+}
+
+static TBitField Sample(int len)
+{
+  TBitField bf(len);
+  for (int i = 0; i < len; i += 3)
+    bf.SetBit(i);
+  return bf;
+}
+
+TEST(TMappedBitField, mapped_field_equals_saved_field)
+{
+  TBitField bf = Sample(100001);
+  SaveToFile(bf);
+
+  TMappedBitField m(MappedFile, TMappedBitField::ReadOnly, 1);
+
+  EXPECT_EQ(100001, m.GetLength());
+  EXPECT_EQ(bf.Count(), m.Count());
+  EXPECT_EQ(bf.FindLast(), m.FindLast());
+  EXPECT_EQ(bf, m.GetField());
+  std::remove(MappedFile);
+}
+
+TEST(TMappedBitField, supports_operations_with_bitfields)
+{
+  TBitField bf = Sample(1000), other(1000);
+  other.SetBit(1);
+  other.SetBit(3);
+  SaveToFile(bf);
+  TMappedBitField m(MappedFile);
+  m.Advise(TMappedBitField::Sequential);
+
+  const TBitField &f = m;
+  TBitField res = f | other;
+  TBitField lazy = ~m.GetField().Lazy() & other;
+
+  EXPECT_EQ(bf.Count() + 1, res.Count());
+  EXPECT_EQ(1, res.GetBit(1));
+  EXPECT_EQ(res, m.GetField() | other);
+  EXPECT_EQ(1, lazy.Count());
+  std::remove(MappedFile);
+}
+
+TEST(TMappedBitField, can_change_bits_only_in_copy_on_write_mode)
+{
+  SaveToFile(Sample(77));
+  TMappedBitField ro(MappedFile);
+  TMappedBitField cow(MappedFile, TMappedBitField::CopyOnWrite);
+
+  ASSERT_ANY_THROW(ro.SetBit(1));
+  cow.SetBit(1);
+  cow.ClrBit(0);
+
+  EXPECT_EQ(1, cow.GetBit(1));
+  EXPECT_EQ(0, cow.GetBit(0));
+  EXPECT_EQ(0, ro.GetBit(1));
+  EXPECT_EQ(1, ro.GetBit(0));
+  std::remove(MappedFile);
+}
+
+TEST(TMappedBitField, throws_when_file_is_missing_or_corrupted)
+{
+  ASSERT_ANY_THROW(TMappedBitField m("no_such_file.tmp"));
+  {
+    std::ofstream os(MappedFile, std::ios::binary);
+    os << "not a bitfield at all, just some text";
+  }
+  ASSERT_ANY_THROW(TMappedBitField m(MappedFile));
+  std::remove(MappedFile);
+}
+
+TEST(TMappedBitField, throws_when_file_has_data_after_record)
+{
+  TBitField bf = Sample(100);
+  SaveToFile(bf);
+  {
+    std::ofstream os(MappedFile, std::ios::binary | std::ios::app);
+    os.write("\0\0\0\0", 4); // нулевые байты тоже не принимаются
+  }
+
+  ASSERT_ANY_THROW(TMappedBitField m(MappedFile));
+  {
+    std::ofstream os(MappedFile, std::ios::binary | std::ios::app);
+    os << "tail";
+  }
+  ASSERT_ANY_THROW(TMappedBitField m(MappedFile));
+  std::remove(MappedFile);
+}
@@ -0,0 +1,124 @@
+#include "tprimesieve.h"
+
+#include <gtest.h>
+
+TEST(TPrimeSieve, counts_primes_for_small_limits)
+{
+  EXPECT_EQ(0, TPrimeSieve::CountPrimes(-5));
+  EXPECT_EQ(0, TPrimeSieve::CountPrimes(1));
+  EXPECT_EQ(1, TPrimeSieve::CountPrimes(2));
+  EXPECT_EQ(2, TPrimeSieve::CountPrimes(3));
+  EXPECT_EQ(4, TPrimeSieve::CountPrimes(7));
+  EXPECT_EQ(4, TPrimeSieve::CountPrimes(10));
+  EXPECT_EQ(25, TPrimeSieve::CountPrimes(100));
+}
+
+TEST(TPrimeSieve, counts_primes_across_many_segments)
+{
+  EXPECT_EQ(78498, TPrimeSieve::CountPrimes(1000000));
+  EXPECT_EQ(664579, TPrimeSieve::CountPrimes(10000000));
+  EXPECT_EQ(5761455, TPrimeSieve::CountPrimes(100000000));
+}
+
+TEST(TPrimeSieve, iterates_first_primes)
+{
+  const long long exp[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+  int k = 0;
+  for (long long p : TPrimeSieve(40))
+  {
+    ASSERT_LT(k, 12);
+    EXPECT_EQ(exp[k++], p);
+  }
+  EXPECT_EQ(12, k);
+}
+
+TEST(TPrimeSieve, iteration_matches_simple_sieve)
+{
+  const int n = 1500007; // несколько сегментов, последний неполный
+  TBitField composite(n + 1);
+  for (int m = 2; (long long)m * m <= n; m++)
+    if (!composite.GetBit(m))
+      for (int k = m * m; k <= n; k += m)
+        composite.SetBit(k);
+
+  TPrimeSieve s(n);
+  int m = 2;
+  for (long long p = s.NextPrime(); p != -1; p = s.NextPrime(), m++)
+  {
+    while (composite.GetBit(m))
+      m++;
+    ASSERT_EQ(m, p);
+  }
+  while ((m <= n) && composite.GetBit(m))
+    m++;
+  EXPECT_EQ(n + 1, m);
+  EXPECT_EQ(-1, s.NextPrime());
+}
+
+static int IsPrime(long long n) // проверка делением
+{
+  if (n < 2)
+    return 0;
+  for (long long d = 2; d * d <= n; d++)
+    if (n % d == 0)
+      return 0;
+  return 1;
+}
+
+TEST(TPrimeSieve, iterates_primes_of_range_near_large_limit)
+{
+  const long long hi = 1000000000000ll, lo = hi - 100; // 10^12
+  long long last = -1;
+  int count = 0, exp = 0;
+  for (long long p : TPrimeSieve(lo, hi))
+  {
+    EXPECT_TRUE(IsPrime(p)) << p;
+    EXPECT_GE(p, lo);
+    last = p;
+    count++;
+  }
+  for (long long n = lo; n <= hi; n++)
+    exp += IsPrime(n);
+
+  EXPECT_EQ(999999999989ll, last);
+  EXPECT_EQ(exp, count);
+  EXPECT_EQ(exp, TPrimeSieve::CountPrimes(lo, hi));
+}
+
+TEST(TPrimeSieve, counts_primes_of_range)
+{
+  EXPECT_EQ(4, TPrimeSieve::CountPrimes(2, 7));
+  EXPECT_EQ(3, TPrimeSieve::CountPrimes(3, 7));
+  EXPECT_EQ(0, TPrimeSieve::CountPrimes(8, 10));
+  EXPECT_EQ(664579 - 78498, TPrimeSieve::CountPrimes(1000001, 10000000));
+}
+
+TEST(TPrimeSieve, parallel_count_matches_serial)
+{
+  EXPECT_EQ(5761455, TPrimeSieve::CountPrimes(0, 100000000, 4));
+  EXPECT_EQ(4, TPrimeSieve::CountPrimes(0, 10, 3));
+  EXPECT_EQ(0, TPrimeSieve::CountPrimes(10, 5, 3));
+  EXPECT_EQ(TPrimeSieve::CountPrimes(123457, 7654321),
+            TPrimeSieve::CountPrimes(123457, 7654321, 5));
+}
+
+static void Collect(long long p, void *ctx)
+{
+  ((std::vector<long long> *)ctx)->push_back(p);
+}
+
+TEST(TPrimeSieve, parallel_visit_yields_primes_in_order)
+{
+  const long long lo = 1000, hi = 60000000; // несколько частей
+  std::vector<long long> exp, res;
+  for (long long p : TPrimeSieve(lo, hi))
+    exp.push_back(p);
+  TPrimeSieve::VisitPrimes(lo, hi, 3, Collect, &res);
+
+  EXPECT_EQ(exp, res);
+}
+
+TEST(TPrimeSieve, throws_when_limit_is_too_large)
+{
+  ASSERT_ANY_THROW(TPrimeSieve s(TPrimeSieve::MaxLimit + 1));
+}
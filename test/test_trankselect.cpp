@@ -0,0 +1,119 @@
+#include "trankselect.h"
+
+#include <gtest.h>
+
+TEST(TRankSelect, rank_of_empty_bitfield_is_zero)
+{
+  TBitField bf(5000);
+  TRankSelect rs(bf);
+
+  EXPECT_EQ(0, rs.GetCount());
+  EXPECT_EQ(0, rs.Rank(0));
+  EXPECT_EQ(0, rs.Rank(5000));
+}
+
+TEST(TRankSelect, rank_matches_count_range)
+{
+  const int size = 10000;
+  TBitField bf(size);
+  for (int i = 0; i < size; i += 7)
+    bf.SetBit(i);
+  for (int i = 4000; i < 6000; i++)
+    bf.SetBit(i);
+  TRankSelect rs(bf);
+
+  for (int n = 0; n <= size; n += 13)
+    EXPECT_EQ(bf.CountRange(0, n), rs.Rank(n));
+  EXPECT_EQ(bf.Count(), rs.Rank(size));
+}
+
+TEST(TRankSelect, select_is_inverse_of_rank)
+{
+  const int size = 100000;
+  TBitField bf(size);
+  for (int i = 0; i < size; i += 3)
+    bf.SetBit(i);
+  for (int i = 50000; i < 60000; i++)
+    bf.SetBit(i);
+  TRankSelect rs(bf);
+
+  int k = 0;
+  for (int n : bf)
+  {
+    ASSERT_EQ(n, rs.Select(k));
+    ASSERT_EQ(k, rs.Rank(n));
+    k++;
+  }
+  EXPECT_EQ(rs.GetCount(), k);
+}
+
+TEST(TRankSelect, throws_when_select_out_of_range)
+{
+  TBitField bf(100);
+  bf.SetBit(10);
+  TRankSelect rs(bf);
+
+  ASSERT_ANY_THROW(rs.Select(1));
+  ASSERT_ANY_THROW(rs.Select(-1));
+  ASSERT_ANY_THROW(rs.Rank(101));
+}
+
+TEST(TRankSelect, index_is_updated_by_set_and_clear_bit)
+{
+  const int size = 10000;
+  TBitField bf(size);
+  bf.SetBit(9000);
+  TRankSelect rs(bf);
+
+  rs.SetBit(100);
+  rs.SetBit(3000);
+  rs.SetBit(3000);
+  rs.ClrBit(9000);
+
+  EXPECT_EQ(2, rs.GetCount());
+  EXPECT_EQ(1, rs.Rank(3000));
+  EXPECT_EQ(2, rs.Rank(size));
+  EXPECT_EQ(3000, rs.Select(1));
+  EXPECT_EQ(0, bf.GetBit(9000));
+}
+
+TEST(TRankSelect, throws_when_field_changed_bypassing_index)
+{
+  TBitField bf(10000);
+  bf.SetBit(5);
+  TRankSelect rs(bf);
+
+  bf.SetBit(7);
+
+  EXPECT_FALSE(rs.IsFresh());
+  ASSERT_ANY_THROW(rs.Rank(100));
+  ASSERT_ANY_THROW(rs.Select(0));
+  rs.Build();
+  EXPECT_EQ(2, rs.Rank(100));
+}
+
+TEST(TRankSelect, throws_when_field_is_reassigned_or_moved)
+{
+  TBitField bf(10000);
+  bf.SetBit(9999);
+  TRankSelect rs(bf);
+
+  bf = TBitField(100);
+  ASSERT_ANY_THROW(rs.Select(0));
+  rs.Build();
+  TBitField other(std::move(bf));
+
+  EXPECT_FALSE(rs.IsFresh());
+  ASSERT_ANY_THROW(rs.GetCount());
+}
+
+TEST(TRankSelect, index_takes_less_than_four_percent_of_bitfield)
+{
+  const int size = 1 << 22;
+  TBitField bf(size);
+  for (int i = 0; i < size; i++)
+    bf.SetBit(i);
+  TRankSelect rs(bf);
+
+  EXPECT_LT(rs.IndexSize(), size / 8 * 4 / 100);
+}
@@ -0,0 +1,218 @@
+#include "troaringset.h"
+
+#include <gtest.h>
+
+TEST(TRoaringSet, can_get_max_power_set)
+{
+  const int size = 5;
+  TRoaringSet set(size);
+
+  EXPECT_EQ(size, set.GetMaxPower());
+}
+
+TEST(TRoaringSet, throws_when_create_set_with_negative_power)
+{
+  ASSERT_ANY_THROW(TRoaringSet set(-1));
+}
+
+TEST(TRoaringSet, can_insert_and_delete_elements)
+{
+  const int size = 1 << 20;
+  TRoaringSet set(size);
+  set.InsElem(3);
+  set.InsElem(70000);
+  set.InsElem(70000);
+
+  EXPECT_NE(0, set.IsMember(3));
+  EXPECT_NE(0, set.IsMember(70000));
+  EXPECT_EQ(0, set.IsMember(4));
+  EXPECT_EQ(2, set.Cardinality());
+
+  set.DelElem(3);
+  EXPECT_EQ(0, set.IsMember(3));
+  EXPECT_EQ(1, set.ContainerCount());
+}
+
+TEST(TRoaringSet, throws_when_insert_element_out_of_range)
+{
+  TRoaringSet set(10);
+
+  ASSERT_ANY_THROW(set.InsElem(10));
+  ASSERT_ANY_THROW(set.IsMember(-1));
+}
+
+TEST(TRoaringSet, memory_of_sparse_set_does_not_depend_on_max_power)
+{
+  TRoaringSet set(2147483647);
+  for (int i = 0; i < 5; i++)
+    set.InsElem(i * 100000000);
+
+  EXPECT_EQ(5, set.Cardinality());
+  EXPECT_LT(set.MemoryUsage(), 1024);
+}
+
+TEST(TRoaringSet, containers_switch_between_array_and_bitmap)
+{
+  const int size = 1 << 16;
+  TRoaringSet set(size);
+  for (int i = 0; i < 5000; i++)
+    set.InsElem(i * 13);
+  for (int i = 0; i < 5000; i++)
+    ASSERT_NE(0, set.IsMember(i * 13));
+  EXPECT_EQ(0, set.IsMember(14));
+
+  for (int i = 0; i < 4990; i++)
+    set.DelElem(i * 13);
+  EXPECT_EQ(10, set.Cardinality());
+  EXPECT_LT(set.MemoryUsage(), 1024);
+}
+
+TEST(TRoaringSet, can_combine_two_sets_of_non_equal_size)
+{
+  const int size1 = 5, size2 = 200000;
+  TRoaringSet set1(size1), set2(size2), expSet(size2);
+  // set1 = {1, 2, 4}
+  set1.InsElem(1);
+  set1.InsElem(2);
+  set1.InsElem(4);
+  // set2 = {0, 1, 150000}
+  set2.InsElem(0);
+  set2.InsElem(1);
+  set2.InsElem(150000);
+  // expSet = {0, 1, 2, 4, 150000}
+  expSet.InsElem(0);
+  expSet.InsElem(1);
+  expSet.InsElem(2);
+  expSet.InsElem(4);
+  expSet.InsElem(150000);
+
+  EXPECT_EQ(expSet, set1 + set2);
+}
+
+TEST(TRoaringSet, can_intersect_two_sets)
+{
+  const int size = 300000;
+  TRoaringSet set1(size), set2(size), expSet(size);
+  for (int i = 0; i < size; i += 2)
+    set1.InsElem(i);
+  for (int i = 0; i < size; i += 3)
+    set2.InsElem(i);
+  for (int i = 0; i < size; i += 6)
+    expSet.InsElem(i);
+
+  EXPECT_EQ(expSet, set1 * set2);
+}
+
+TEST(TRoaringSet, check_negation_operator)
+{
+  const int size = 200000;
+  TRoaringSet set(size);
+  set.InsElem(1);
+  set.InsElem(100000);
+  TRoaringSet neg = ~set;
+
+  EXPECT_EQ(size - 2, neg.Cardinality());
+  EXPECT_EQ(0, neg.IsMember(1));
+  EXPECT_EQ(0, neg.IsMember(100000));
+  EXPECT_NE(0, neg.IsMember(199999));
+  EXPECT_EQ(set, ~neg);
+}
+
+TEST(TRoaringSet, can_convert_to_and_from_tset)
+{
+  const int size = 100000;
+  TSet set(size);
+  for (int i = 0; i < size; i += 7)
+    set.InsElem(i);
+  for (int i = 50000; i < 60000; i++)
+    set.InsElem(i);
+  TRoaringSet rset(set);
+
+  EXPECT_EQ(set.Cardinality(), rset.Cardinality());
+  EXPECT_EQ(set, TSet(rset));
+}
+
+TEST(TRoaringSet, run_optimize_keeps_elements_and_saves_memory)
+{
+  const int size = 1 << 17;
+  TRoaringSet set(size);
+  for (int i = 1000; i < 100000; i++)
+    set.InsElem(i);
+  TRoaringSet opt(set);
+  opt.RunOptimize();
+
+  EXPECT_EQ(set, opt);
+  EXPECT_LT(opt.MemoryUsage(), set.MemoryUsage());
+}
+
+TEST(TRoaringSet, insert_and_delete_on_run_containers_match_tset)
+{
+  const int size = 1 << 17;
+  TSet set(size);
+  for (int i = 1000; i < 100000; i++)
+    set.InsElem(i);
+  TRoaringSet rset(set);
+  const int ins[] = { 999, 100000, 100002, 100001, 5, 7, 6, 131071 };
+  const int del[] = { 1000, 99999, 50000, 50002, 50001, 5, 6, 7, 131071 };
+  for (int k = 0; k < 8; k++)
+  {
+    set.InsElem(ins[k]);
+    rset.InsElem(ins[k]);
+    EXPECT_EQ(set, TSet(rset));
+  }
+  for (int k = 0; k < 9; k++)
+  {
+    set.DelElem(del[k]);
+    rset.DelElem(del[k]);
+    EXPECT_EQ(set, TSet(rset));
+  }
+  EXPECT_EQ(set.Cardinality(), rset.Cardinality());
+}
+
+TEST(TRoaringSet, conversion_from_tset_picks_compact_containers)
+{
+  const int size = 200000;
+  TSet set(size);
+  for (int i = 10; i < 60000; i++)
+    set.InsElem(i);
+  set.InsElem(150000);
+  TRoaringSet rset(set);
+
+  EXPECT_EQ(2, rset.ContainerCount());
+  EXPECT_LT(rset.MemoryUsage(), 200);
+  EXPECT_EQ(set, TSet(rset));
+}
+
+TEST(TRoaringSet, combine_in_place_keeps_max_power)
+{
+  const int size1 = 70000, size2 = 200000;
+  TRoaringSet set1(size1), set2(size2);
+  set2.InsElem(69999);
+  set2.InsElem(70000);
+  set2.InsElem(150000);
+  set1 += set2;
+
+  EXPECT_EQ(size1, set1.GetMaxPower());
+  EXPECT_EQ(1, set1.Cardinality());
+}
+
+TEST(TRoaringSet, union_and_intersection_of_many_match_pairwise)
+{
+  const int size = 300000, k = 4;
+  std::vector<TRoaringSet> sets;
+  for (int j = 0; j < k; j++)
+    sets.push_back(TRoaringSet(size - j * 50000));
+  for (int i = 0; i < 250000; i += 3)
+    sets[0].InsElem(i);
+  for (int i = 0; i < 200000; i += 2)
+    sets[1].InsElem(i);
+  for (int i = 10000; i < 150000; i++)
+    sets[2].InsElem(i);
+  sets[3].InsElem(12000);
+  sets[3].InsElem(140000);
+  const TRoaringSet *p[k] = { &sets[0], &sets[1], &sets[2], &sets[3] };
+
+  EXPECT_EQ(sets[0] + sets[1] + sets[2] + sets[3], TRoaringSet::UnionAll(p, k));
+  EXPECT_EQ(sets[0] * sets[1] * sets[2] * sets[3], TRoaringSet::IntersectAll(p, k));
+  EXPECT_EQ(sets[0] * sets[1] * sets[2], TRoaringSet::IntersectAll(p, 3));
+}
@@ -2,6 +2,9 @@
 
 #include <gtest.h>
 
+#include <sstream>
+#include <vector>
+
 TEST(TSet, can_get_max_power_set)
 {
   const int size = 5;
@@ -51,6 +54,21 @@ TEST(TSet, can_delete_existing_element)
   EXPECT_EQ(set.IsMember(k), 0);
 }
 
+TEST(TSet, can_insert_and_delete_range_of_elements)
+{
+  TSet set(100);
+
+  set.InsRange(10, 70);
+  set.DelRange(20, 30);
+
+  EXPECT_EQ(50, set.Cardinality());
+  EXPECT_EQ(10, set.FindFirst());
+  EXPECT_EQ(69, set.FindLast());
+  EXPECT_EQ(0, set.IsMember(25));
+  EXPECT_EQ(30, set.FindNext(19));
+  ASSERT_ANY_THROW(set.InsRange(90, 101));
+}
+
 TEST(TSet, compare_two_sets_of_non_equal_sizes)
 {
   const int size1 = 4, size2 = 6;
@@ -295,3 +313,338 @@ TEST(TSet, check_negation_operator)
 
   EXPECT_EQ(expSet, set1);
 }
+
+TEST(TSet, can_combine_in_place)
+{
+  const int size = 5;
+  TSet set1(size), set2(size), expSet(size);
+  // set1 = {1, 2, 4}
+  set1.InsElem(1);
+  set1.InsElem(2);
+  set1.InsElem(4);
+  // set2 = {0, 1}
+  set2.InsElem(0);
+  set2.InsElem(1);
+  set1 += set2;
+  // expSet = {0, 1, 2, 4}
+  expSet.InsElem(0);
+  expSet.InsElem(1);
+  expSet.InsElem(2);
+  expSet.InsElem(4);
+
+  EXPECT_EQ(expSet, set1);
+}
+
+TEST(TSet, in_place_operations_keep_max_power)
+{
+  const int size1 = 5, size2 = 7;
+  TSet set1(size1), set2(size2);
+  set2.InsElem(6);
+  set1 += set2;
+
+  EXPECT_EQ(size1, set1.GetMaxPower());
+}
+
+TEST(TSet, can_intersect_in_place)
+{
+  const int size1 = 7, size2 = 5;
+  TSet set1(size1), set2(size2), expSet(size1);
+  // set1 = {1, 2, 6}
+  set1.InsElem(1);
+  set1.InsElem(2);
+  set1.InsElem(6);
+  // set2 = {2, 4}
+  set2.InsElem(2);
+  set2.InsElem(4);
+  set1 *= set2;
+  // expSet = {2}
+  expSet.InsElem(2);
+
+  EXPECT_EQ(expSet, set1);
+}
+
+TEST(TSet, can_subtract_in_place)
+{
+  const int size = 5;
+  TSet set1(size), set2(size), expSet(size);
+  // set1 = {1, 2, 4}
+  set1.InsElem(1);
+  set1.InsElem(2);
+  set1.InsElem(4);
+  // set2 = {2, 3}
+  set2.InsElem(2);
+  set2.InsElem(3);
+  set1 -= set2;
+  // expSet = {1, 4}
+  expSet.InsElem(1);
+  expSet.InsElem(4);
+
+  EXPECT_EQ(expSet, set1);
+}
+
+TEST(TSet, can_find_symmetric_difference_in_place)
+{
+  const int size = 5;
+  TSet set1(size), set2(size), expSet(size);
+  // set1 = {1, 2, 4}
+  set1.InsElem(1);
+  set1.InsElem(2);
+  set1.InsElem(4);
+  // set2 = {2, 3}
+  set2.InsElem(2);
+  set2.InsElem(3);
+  set1 ^= set2;
+  // expSet = {1, 3, 4}
+  expSet.InsElem(1);
+  expSet.InsElem(3);
+  expSet.InsElem(4);
+
+  EXPECT_EQ(expSet, set1);
+}
+
+TEST(TSet, can_move_set)
+{
+  const int size = 5;
+  TSet set1(size);
+  set1.InsElem(3);
+  TSet set2(std::move(set1));
+
+  EXPECT_EQ(size, set2.GetMaxPower());
+  EXPECT_NE(0, set2.IsMember(3));
+}
+
+TEST(TSet, can_combine_temporary_sets_of_non_equal_size)
+{
+  const int size1 = 5, size2 = 7;
+  TSet set1(size1), set2(size2), expSet(size2);
+  // set1 = {1}, set2 = {6}
+  set1.InsElem(1);
+  set2.InsElem(6);
+  // expSet = {1, 3, 6}
+  expSet.InsElem(1);
+  expSet.InsElem(3);
+  expSet.InsElem(6);
+
+  EXPECT_EQ(expSet, (TSet(set1) + 3) + set2);
+  EXPECT_EQ(expSet, set2 + (set1 + 3));
+}
+
+TEST(TSet, can_get_cardinality)
+{
+  const int size = 100;
+  TSet set(size);
+  set.InsElem(1);
+  set.InsElem(50);
+  set.InsElem(99);
+
+  EXPECT_EQ(3, set.Cardinality());
+  EXPECT_EQ(size - 3, (~set).Cardinality());
+}
+
+TEST(TSet, can_iterate_over_elements)
+{
+  const int size = 50;
+  TSet set(size);
+  // set = {2, 7, 40}
+  set.InsElem(40);
+  set.InsElem(2);
+  set.InsElem(7);
+
+  int sum = 0, cnt = 0;
+  for (int e : set)
+  {
+    sum += e;
+    cnt++;
+  }
+
+  EXPECT_EQ(3, cnt);
+  EXPECT_EQ(49, sum);
+  EXPECT_EQ(7, set.FindNext(2));
+  EXPECT_EQ(40, set.FindLast());
+}
+
+TEST(TSet, results_of_operations_use_resource_of_operands)
+{
+  char buf[4096];
+  std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+  TSet a(1000, &arena), b(1000, &arena);
+  a.InsElem(1);
+  b.InsElem(999);
+
+  TSet c = (a + b) * ~a + 5;
+
+  EXPECT_EQ(&arena, c.GetResource());
+  EXPECT_EQ(2, c.Cardinality());
+}
+
+TEST(TSet, move_assignment_between_resources_keeps_source_consistent)
+{
+  char buf[4096];
+  std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+  TSet a(1000, &arena), b(10);
+  a.InsElem(999);
+
+  b = std::move(a); // память не перенимается, поле копируется
+
+  EXPECT_EQ(1000, b.GetMaxPower());
+  EXPECT_NE(0, b.IsMember(999));
+  EXPECT_EQ(1000, a.GetMaxPower());
+  ASSERT_NO_THROW(a.InsElem(500));
+}
+
+TEST(TSet, fused_expression_matches_step_by_step_evaluation)
+{
+  const int size = 150;
+  TSet a(size), b(size), c(size), d(size);
+  for (int i = 0; i < size; i += 2)
+    a.InsElem(i);
+  for (int i = 0; i < size; i += 3)
+    b.InsElem(i);
+  for (int i = 0; i < size; i += 5)
+    c.InsElem(i);
+  d.InsElem(149);
+  TSet t1 = a + b;
+  TSet t2 = ~c;
+  TSet t3 = t1 * t2;
+  TSet expSet = t3 + d;
+
+  TSet set = (a.Lazy() + b) * ~c.Lazy() + d;
+
+  EXPECT_EQ(expSet, set);
+  EXPECT_EQ(expSet.Cardinality(), ((a.Lazy() + b) * ~c.Lazy() + d).Cardinality());
+  EXPECT_EQ(expSet.IsMember(149), ((a.Lazy() + b) * ~c.Lazy() + d).IsMember(149));
+  EXPECT_EQ(expSet + 1, (a.Lazy() + b) * ~c.Lazy() + d + 1);
+}
+
+TEST(TSet, union_and_intersection_of_many_match_pairwise)
+{
+  const int size = 50000, k = 4;
+  std::vector<TSet> sets;
+  for (int j = 0; j < k; j++)
+  {
+    TSet s(size);
+    for (int i = 0; i < size; i += j + 2)
+      s.InsElem(i);
+    sets.push_back(std::move(s));
+  }
+  const TSet *p[k] = { &sets[0], &sets[1], &sets[2], &sets[3] };
+
+  EXPECT_EQ(((sets[0] + sets[1]) + sets[2]) + sets[3], TSet::UnionAll(p, k));
+  EXPECT_EQ(((sets[0] * sets[1]) * sets[2]) * sets[3], TSet::IntersectAll(p, k));
+}
+
+TEST(TSet, output_writes_elements_in_braces)
+{
+  TSet s(2000000000), empty(5);
+  std::ostringstream os, osEmpty;
+  s.InsElem(0);
+  s.InsElem(7);
+  s.InsElem(99);
+  s.InsElem(1000000);
+  s.InsElem(1999999999);
+
+  os << s;
+  osEmpty << empty;
+
+  EXPECT_EQ("{0, 7, 99, 1000000, 1999999999}", os.str());
+  EXPECT_EQ("{}", osEmpty.str());
+}
+
+TEST(TSet, output_of_large_set_matches_element_list)
+{
+  const int size = 100000;
+  TSet s(size);
+  std::string exp = "{";
+  for (int i = 1; i < size; i += 7) // несколько буферов вывода
+    s.InsElem(i);
+  for (int e : s)
+    exp += ((exp.size() > 1) ? ", " : "") + std::to_string(e);
+  exp += "}";
+  std::ostringstream os;
+
+  os << s;
+
+  EXPECT_EQ(exp, os.str());
+}
+
+TEST(TSet, input_reads_elements_with_optional_braces_and_commas)
+{
+  TSet s(100), exp(100);
+  exp.InsElem(0);
+  exp.InsElem(5);
+  exp.InsElem(17);
+  exp.InsElem(99);
+  std::istringstream is1("{0, 5,17 ,\n 99} tail"), is2("  99 17 5 0");
+
+  is1 >> s;
+  EXPECT_EQ(exp, s);
+  EXPECT_EQ(' ', is1.peek());
+  is2 >> s;
+  EXPECT_EQ(exp, s);
+  EXPECT_TRUE(is2.eof());
+}
+
+TEST(TSet, input_stops_on_non_numeric_element)
+{
+  TSet s(10), exp(10);
+  exp.InsElem(1);
+  std::istringstream is("{1, x}");
+
+  is >> s;
+
+  EXPECT_EQ(exp, s);
+  EXPECT_TRUE(is.fail());
+}
+
+TEST(TSet, throws_when_input_element_is_out_of_range)
+{
+  TSet s(10);
+  std::istringstream is1("{1, 10}"), is2("{-1}");
+
+  ASSERT_ANY_THROW(is1 >> s);
+  ASSERT_ANY_THROW(is2 >> s);
+}
+
+TEST(TSet, input_of_output_restores_set)
+{
+  const int size = 100003;
+  TSet s(size), res(size);
+  for (int i = 0; i < size; i += 7)
+    s.InsElem(i);
+  std::stringstream ss;
+
+  ss << s;
+  ss >> res;
+
+  EXPECT_EQ(s, res);
+}
+
+TEST(TSet, load_of_saved_set_restores_set_and_max_power)
+{
+  TSet s(1000), res(10);
+  for (int i = 0; i < 1000; i += 13)
+    s.InsElem(i);
+  std::stringstream ss;
+
+  s.Save(ss);
+  res.Load(ss);
+
+  EXPECT_EQ(1000, res.GetMaxPower());
+  EXPECT_EQ(s, res);
+}
+
+TEST(TSet, failed_load_leaves_set_unchanged)
+{
+  TSet s(1000), res(10);
+  s.InsElem(500);
+  res.InsElem(3);
+  std::vector<char> buf(s.SaveSize());
+  s.Save(buf.data(), buf.size());
+  buf[30] ^= 1;
+  std::stringstream ss(std::string(buf.data(), buf.size()));
+
+  ASSERT_ANY_THROW(res.Load(buf.data(), buf.size()));
+  ASSERT_ANY_THROW(res.Load(ss));
+  EXPECT_EQ(10, res.GetMaxPower());
+  EXPECT_NE(0, res.IsMember(3));
+}